@@ -204,7 +204,11 @@ Java_github_tianzerl_anime4kcpp_warpper_Anime4K_saveVideoAnime4K(
         JNIEnv *env,
         jobject /* this */,
         jlong ptrAnime4K) {
-    ((Anime4KCPP::Anime4K*)(ptrAnime4K))->saveVideo();
+    try {
+        ((Anime4KCPP::Anime4K*)(ptrAnime4K))->saveVideo();
+    } catch (const char* err) {
+        env->ThrowNew(env->FindClass("java/lang/Exception"), err);
+    }
 }
 
 JNIEXPORT jboolean JNICALL
@@ -9,21 +9,9 @@
 #include<opencv2/videoio.hpp>
 #include<opencv2/core/hal/interface.h>
 
+#include"dll.h"
 #include"VideoIO.h"
 
-#ifdef _MSC_VER
-#ifndef DLL
-#define DLL __declspec(dllimport)
-#else
-#undef DLL
-#define DLL __declspec(dllexport)
-#endif
-#else
-#ifndef DLL
-#define DLL
-#endif
-#endif
-
 namespace Anime4KCPP
 {
     struct DLL Parameters;
@@ -43,6 +31,14 @@ namespace Anime4KCPP
         BILATERAL_FILTER = 32, BILATERAL_FILTER_FAST = 64
     };
 
+    //element type used by CPU CNN for weights and feature maps, compared by the CLI with --comparePrecision.
+    //INT8 quantizes the weights of every layer to int8 with a scale of its own and keeps feature maps as
+    //int16, summed in int32
+    enum class CNNPrecision
+    {
+        DOUBLE, FLOAT, INT8
+    };
+
     typedef unsigned char* RGBA;
     typedef unsigned char* Line;
 }
@@ -61,6 +57,8 @@ struct Anime4KCPP::Parameters
     uint8_t preFilters;
     uint8_t postFilters;
     unsigned int maxThreads;
+    CNNPrecision cnnPrecision;
+    ParallelPolicy parallelPolicy;
 
     void reset();
 
@@ -76,7 +74,9 @@ struct Anime4KCPP::Parameters
         bool postprocessing = false,
         uint8_t preFilters = 4,
         uint8_t postFilters = 40,
-        unsigned int maxThreads = std::thread::hardware_concurrency()
+        unsigned int maxThreads = std::thread::hardware_concurrency(),
+        CNNPrecision cnnPrecision = CNNPrecision::DOUBLE,
+        ParallelPolicy parallelPolicy = ParallelPolicy::AUTO
     );
 };
 
@@ -100,7 +100,9 @@ public:
     void loadImage(int rows, int cols, unsigned char* data, size_t bytesPerLine = 0ULL);
     void loadImage(int rows, int cols, unsigned char* r, unsigned char* g, unsigned char* b);
 
-    void setVideoSaveInfo(const std::string& dstFile, const CODEC codec = CODEC::MP4V);
+    //segments > 1 writes the video as that many files processed at once, checkpointFrames > 0 starts a new
+    //file every that many frames, so a killed job can resume, see VideoIO::openWriter
+    void setVideoSaveInfo(const std::string& dstFile, const CODEC codec = CODEC::MP4V, const size_t segments = 1, const size_t checkpointFrames = 0);
     void saveImage(const std::string& dstFile);
     void saveImage(cv::Mat& dstImage);
     void saveImage(unsigned char*& data);
@@ -130,5 +132,7 @@ protected://arguments
     bool fm, vm, pre, post;
     uint8_t pref, postf;
     unsigned int mt;
+    CNNPrecision cnnp;
+    ParallelPolicy pp;
 };
 
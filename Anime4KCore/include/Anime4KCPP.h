@@ -3,6 +3,7 @@
 #include "Anime4KCPU.h"
 #include "Anime4KGPU.h"
 #include "Anime4KCPUCNN.h"
+#include "Anime4KGPUCNN.h"
 
 #define ANIME4KCPP_CORE_VERSION "1.9.5"
 
@@ -14,7 +15,9 @@ namespace Anime4KCPP
 class Anime4KCPP::Anime4KCreator
 {
 public:
-    Anime4KCreator(bool initGPU = false, unsigned int platformID = 0, unsigned int deviceID = 0);
+    Anime4KCreator(bool initGPU = false, unsigned int platformID = 0, unsigned int deviceID = 0, const cl_device_type deviceType = CL_DEVICE_TYPE_GPU);
+    //initialize Anime4KGPU with several devices as {platformID, deviceID}
+    Anime4KCreator(bool initGPU, const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs, const cl_device_type deviceType = CL_DEVICE_TYPE_GPU);
     ~Anime4KCreator();
     Anime4K* create(const Parameters& parameters, const ProcessorType type);
     void release(Anime4K*& anime4K);
@@ -2,12 +2,9 @@
 
 #include"Anime4K.h"
 #include"filterprocessor.h"
+#include"simd.h"
 
-#ifdef _MSC_VER
-#include<ppl.h>
-#else
-#include<omp.h>
-#endif
+#include"threadpool.h"
 
 #define MAX3(a, b, c) std::max({a, b, c})
 #define MIN3(a, b, c) std::min({a, b, c})
@@ -25,11 +22,63 @@ public:
     virtual ~Anime4KCPU() = default;
     virtual void process() override;
 private:
-    void getGray(cv::InputArray img);
-    void pushColor(cv::InputArray img);
-    void getGradient(cv::InputArray img);
-    void pushGradient(cv::InputArray img);
-    void changEachPixelBGRA(cv::InputArray _src, const std::function<void(int, int, RGBA, Line)>&& callBack);
+    //the CLI times the per pixel loops
+    friend class Benchmark;
+
+    void getGray(cv::Mat& img);
+    void pushColor(cv::Mat& img, cv::Mat& tmp);
+    void getGradient(cv::Mat& img, cv::Mat& tmp);
+    void pushGradient(cv::Mat& img, cv::Mat& tmp);
+    void runFusedPass(const cv::Mat& src, cv::Mat& dst, const bool pushColorFlag);
+    void processBand(const cv::Mat& src, cv::Mat& dst, const int begin, const int end, const bool pushColorFlag);
+    void getGrayKernel(RGBA mc);
+    void pushColorKernel(const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData);
+    void getGradientKernel(const int i, const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData);
+    void pushGradientKernel(const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData);
+    void pushColorLine(Line dstLine, const Line nLineData, const Line cLineData, const Line pLineData);
+    void pushGradientLine(Line dstLine, const Line nLineData, const Line cLineData, const Line pLineData);
+    template<typename F>
+    void changEachLineBGRA(const cv::Mat& src, cv::Mat& dst, F&& callBack);
+    template<typename F>
+    void changEachPixelBGRA(const cv::Mat& src, cv::Mat& dst, F&& callBack);
     void getLightest(RGBA mc, RGBA a, RGBA b, RGBA c);
     void getAverage(RGBA mc, RGBA a, RGBA b, RGBA c);
+private:
+    //the other half of the ping-pong buffer pair for image mode, kept between calls
+    cv::Mat tmpImg;
+    //minimum rows of each band in the fused pipeline, bands are recomputed with a 3 lines halo
+    const static int minBandHeight = 32;
 };
+
+template<typename F>
+inline void Anime4KCPP::Anime4KCPU::changEachLineBGRA(const cv::Mat& src, cv::Mat& dst, F&& callBack)
+{
+    //same as changEachPixelBGRA, but hands over whole lines so the callback can use SIMD
+    const size_t lineSize = static_cast<size_t>(W) * static_cast<size_t>(4);
+
+    ThreadPool::instance().parallelFor(0, H, [&](int i) {
+        Line lineData = src.data + static_cast<size_t>(i) * lineSize;
+        Line tmpLineData = dst.data + static_cast<size_t>(i) * lineSize;
+        memcpy(tmpLineData, lineData, lineSize);
+        callBack(i, tmpLineData, lineData);
+        });
+}
+
+template<typename F>
+inline void Anime4KCPP::Anime4KCPU::changEachPixelBGRA(const cv::Mat& src, cv::Mat& dst, F&& callBack)
+{
+    //dst is the other half of a ping-pong pair, each line is copied from src right before
+    //being changed, so no full-frame copy is needed and the caller swaps src and dst after
+    const bool inPlace = src.data == dst.data;
+    const size_t lineSize = static_cast<size_t>(W) * static_cast<size_t>(4);
+
+    int jMAX = W * 4;
+    ThreadPool::instance().parallelFor(0, H, [&](int i) {
+        Line lineData = src.data + static_cast<size_t>(i) * lineSize;
+        Line tmpLineData = dst.data + static_cast<size_t>(i) * lineSize;
+        if (!inPlace)
+            memcpy(tmpLineData, lineData, lineSize);
+        for (int j = 0; j < jMAX; j += 4)
+            callBack(i, j, tmpLineData + j, lineData);
+        });
+}
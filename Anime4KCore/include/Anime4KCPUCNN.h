@@ -1,13 +1,17 @@
 #pragma once
 #include "Anime4K.h"
+#include "simd.h"
 
-#ifdef _MSC_VER
-#include<ppl.h>
-#else
-#include<omp.h>
-#endif
+#include<cstring>
+#include<fstream>
+#include<iterator>
+#include<memory>
+#include<mutex>
+#include<type_traits>
 
-#define RULE(x) std::max(x, 0.0)
+#include"threadpool.h"
+
+#define RULE(x) std::max(x, static_cast<decltype(x)>(0))
 #define NORM(X) (double(X) / 255.0)
 #define UNNORM(n) ((n) >= 255.0? uint8_t(255) : ((n) <= 0.0 ? uint8_t(0) : uint8_t(n)))
 
@@ -18,11 +22,13 @@ namespace Anime4KCPP
         Y = 0, U = 1, V = 2
     };
 
-    typedef double* Chan;
+    template<typename T>
+    using Chan = T*;
     typedef unsigned char* PIXEL;
     typedef unsigned char* LineC;
-    typedef double* LineF;
-    class Anime4KCPUCNN;
+    template<typename T>
+    using LineF = T*;
+    class DLL Anime4KCPUCNN;
 }
 
 class Anime4KCPP::Anime4KCPUCNN :public Anime4K
@@ -32,34 +38,163 @@ public:
     virtual ~Anime4KCPUCNN() = default;
     virtual void process() override;
 
-    void conv1To8(cv::InputArray img, const std::vector<cv::Mat>& kernels, const cv::Mat& biases, std::pair<cv::Mat, cv::Mat>& tmpMats);
-    void conv8To8(const std::vector<std::vector<cv::Mat>>& kernels, const cv::Mat& biases, std::pair<cv::Mat, cv::Mat>& tmpMats);
-    void convTranspose8To1(cv::Mat& img, const std::vector<cv::Mat>& kernels, std::pair<cv::Mat, cv::Mat>& tmpMats);
+    //T is the element type of kernels, biases and feature maps, double or float.
+    //kernels are packed by getLayers as [tap][input channel][output channel], input channels
+    //come from tmpMat and output channels from biases, so any width of the model works.
+    //offset is the column of the first pixel in the whole image when working on a tile,
+    //the layers run on the calling thread, process() spreads tiles over threads.
+    //Output maps already of the right size and type are written in place, so buffers can be reused
+    template<typename T>
+    void convYToN(cv::InputArray img, const cv::Mat& kernels, const cv::Mat& biases, cv::Mat& tmpMat, const int offset = 0);
+    template<typename T>
+    void convNToN(const cv::Mat& kernels, const cv::Mat& biases, const cv::Mat& src, cv::Mat& dst, const int offset = 0);
+    template<typename T>
+    void convTransposeNTo1(cv::Mat& img, const cv::Mat& kernels, cv::Mat& tmpMat);
+
+    //weights are shared by all instances and may be replaced at any time, running networks keep the old ones.
+    //loadModel throws if the file is broken or its layers aren't supported, saveModel writes the current weights
+    static void loadModel(const std::string& path);
+    static void saveModel(const std::string& path);
+    static void useBuiltInModel();
 
 private:
-    void changEachPixel1To8(cv::InputArray _src, const std::function<void(int, int, Chan, Chan, LineC)>&& callBack, std::pair<cv::Mat, cv::Mat>& tmpMats);
-    void changEachPixel8To8(const std::function<void(int, int, Chan, Chan, LineF, LineF)>&& callBack, std::pair<cv::Mat, cv::Mat>& tmpMats);
-    void changEachPixel8To1(cv::Mat& img, const std::function<void(int, int, PIXEL, LineF, LineF)>&& callBack, std::pair<cv::Mat, cv::Mat>& tmpMats);
+    //Anime4KGPUCNN runs the same model
+    friend class Anime4KGPUCNN;
+
+    enum LayerType : uint32_t
+    {
+        CONV3X3 = 0, CONV_TRANSPOSE2X2 = 1
+    };
+
+    //weights as stored in a model file, kernels are [out][in][kernel rows][kernel cols]
+    struct Model
+    {
+        struct Layer
+        {
+            uint32_t type, inChannels, outChannels;
+            std::vector<double> kernels, biases;
+        };
+        std::vector<Layer> layers;
+    };
+
+    //weights of all layers converted to one element type, the first layer reads Y, the last one is
+    //the transposed conv, halo is the receptive field of the 3x3 layers, channels the widest of them
+    //and tileSize the side of the tiles whose feature maps fit cacheBudget.
+    //For INT8, kernels are int8 and biases int32, scales take the int32 sums of every layer to its int16
+    //output, or to a pixel for the last one, and limits are the largest outputs the sums of the next layer
+    //can take without overflow
+    struct Layers
+    {
+        std::vector<cv::Mat> kernels;
+        std::vector<cv::Mat> biases;
+        std::vector<double> scales;
+        std::vector<int> limits;
+        int halo;
+        int channels;
+        int tileSize;
+    };
+
+    static std::shared_ptr<const Model> getModel();
+    static std::shared_ptr<const Model> readModel(const unsigned char* data, size_t size);
+    static void checkModel(const Model& model);
+    //T is int16_t for INT8, the type of its feature maps
+    template<typename T>
+    static std::shared_ptr<const Layers> getLayers();
+    template<typename T>
+    static std::shared_ptr<Layers> convertLayers(const Model& model);
+    static std::shared_ptr<Layers> quantizeLayers(const Model& model);
+    //runNetwork of the element type of cnnp
+    void runNetwork(const cv::Mat& src, cv::Mat& dst);
+    template<typename T>
+    void runNetwork(const cv::Mat& src, cv::Mat& dst);
+    template<typename T>
+    void runTile(const Layers& layers, const cv::Mat& src, cv::Mat& dst, const cv::Rect& tile);
+
+    //layers of INT8, in the same order of taps and channels as the ones above
+    void convYToNFixed(const cv::Mat& img, const cv::Mat& kernels, const cv::Mat& biases, const double scale, const int limit,
+        cv::Mat& tmpMat, const int offset);
+    void convNToNFixed(const cv::Mat& kernels, const cv::Mat& biases, const double scale, const int limit,
+        const cv::Mat& src, cv::Mat& dst, const int offset);
+    void convTransposeNTo1Fixed(cv::Mat& img, const cv::Mat& kernels, const double scale, cv::Mat& tmpMat);
+
+    template<typename T>
+    void convNToNKernel(const int j, Chan<T> tmpChan, const LineF<T> nLineData, const LineF<T> cLineData, const LineF<T> pLineData,
+        const T* kernel, const T* bias, const int cols, const int offset, const int inChannels, const int outChannels, T* sum, T* tmp);
+
+    template<typename T, typename F>
+    void changEachPixelYToN(cv::InputArray _src, F&& callBack, cv::Mat& tmpMat, const int channels);
+    template<typename T, typename F>
+    void changEachLineNToN(const cv::Mat& src, cv::Mat& dst, F&& callBack);
+    template<typename T, typename F>
+    void changEachPixelNTo1(cv::Mat& img, F&& callBack, cv::Mat& tmpMat);
 
 private:
-    const static std::vector<cv::Mat> kernelsL1;
-    const static std::vector<std::vector<cv::Mat>> kernelsL2;
-    const static std::vector<std::vector<cv::Mat>> kernelsL3;
-    const static std::vector<std::vector<cv::Mat>> kernelsL4;
-    const static std::vector<std::vector<cv::Mat>> kernelsL5;
-    const static std::vector<std::vector<cv::Mat>> kernelsL6;
-    const static std::vector<std::vector<cv::Mat>> kernelsL7;
-    const static std::vector<std::vector<cv::Mat>> kernelsL8;
-    const static std::vector<std::vector<cv::Mat>> kernelsL9;
-    const static std::vector<cv::Mat> kernelsL10;
-    const static cv::Mat biasesL1;
-    const static cv::Mat biasesL2;
-    const static cv::Mat biasesL3;
-    const static cv::Mat biasesL4;
-    const static cv::Mat biasesL5;
-    const static cv::Mat biasesL6;
-    const static cv::Mat biasesL7;
-    const static cv::Mat biasesL8;
-    const static cv::Mat biasesL9;
+    //bytes the two feature maps of a tile live at a time may take with its halo, about the L2 of a core,
+    //so a tile runs all layers without going to memory. Tiles are no smaller than minTileSize however
+    //wide the model, or the halo would be most of the work
+    constexpr static size_t cacheBudget = 1 << 20;
+    constexpr static int minTileSize = 32;
+
+    static std::mutex modelMutex;
+    static std::shared_ptr<const Model> currentModel;
+    const static uint32_t builtInLayers[10][3];
+    const static double builtInWeights[];
 };
 
+template<typename T, typename F>
+inline void Anime4KCPP::Anime4KCPUCNN::changEachPixelYToN(cv::InputArray _src,
+    F&& callBack,
+    cv::Mat& tmpMat,
+    const int channels)
+{
+    cv::Mat src = _src.getMat();
+    tmpMat.create(src.size(), CV_MAKETYPE(cv::DataType<T>::depth, channels));
+
+    int h = src.rows, w = src.cols;
+
+    int jMAX = w * channels;
+    for (int i = 0; i < h; i++)
+    {
+        LineC lineData = src.ptr(i);
+        LineF<T> tmpLineData = reinterpret_cast<T*>(tmpMat.data) + static_cast<size_t>(i) * static_cast<size_t>(w) * static_cast<size_t>(channels);
+        for (int j = 0; j < jMAX; j += channels)
+            callBack(i, j, tmpLineData + j, lineData);
+    }
+}
+
+template<typename T, typename F>
+inline void Anime4KCPP::Anime4KCPUCNN::changEachLineNToN(const cv::Mat& src,
+    cv::Mat& dst,
+    F&& callBack)
+{
+    //dst is created by the caller with its channels, src and dst are continuous and never the same
+    int h = src.rows, w = src.cols;
+    const int inChannels = src.channels(), outChannels = dst.channels();
+
+    for (int i = 0; i < h; i++)
+    {
+        LineF<T> lineData = reinterpret_cast<T*>(src.data) + static_cast<size_t>(i) * static_cast<size_t>(w) * static_cast<size_t>(inChannels);
+        LineF<T> tmpLineData = reinterpret_cast<T*>(dst.data) + static_cast<size_t>(i) * static_cast<size_t>(w) * static_cast<size_t>(outChannels);
+        callBack(i, tmpLineData, lineData);
+    }
+}
+
+template<typename T, typename F>
+inline void Anime4KCPP::Anime4KCPUCNN::changEachPixelNTo1(cv::Mat& img,
+    F&& callBack,
+    cv::Mat& tmpMat)
+{
+    //img keeps its buffer when it already has the size
+    int h = 2 * tmpMat.rows, w = 2 * tmpMat.cols;
+    img.create(h, w, CV_8UC1);
+    const int channels = tmpMat.channels();
+
+    int jMAX = w;
+    for (int i = 0; i < h; i++)
+    {
+        LineF<T> lineData = reinterpret_cast<T*>(tmpMat.data) + static_cast<size_t>(i / 2) * static_cast<size_t>(w / 2) * static_cast<size_t>(channels);
+        LineC tmpLineData = img.data + static_cast<size_t>(i) * static_cast<size_t>(w);
+        for (int j = 0; j < jMAX; j++)
+            callBack(i, j, tmpLineData + j, lineData + static_cast<size_t>((j / 2)) * static_cast<size_t>(channels));
+    }
+}
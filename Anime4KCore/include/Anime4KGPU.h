@@ -3,7 +3,11 @@
 #include"Anime4K.h"
 #include"filterprocessor.h"
 
+#include<chrono>
+#include<filesystem>
 #include<fstream>
+#include<mutex>
+#include<thread>
 
 #ifdef __APPLE__
 #include<OpenCL/opencl.h>
@@ -14,6 +18,7 @@
 namespace Anime4KCPP
 {
     class DLL Anime4KGPU;
+    class DLL Anime4KGPUCNN;
 }
 
 class Anime4KCPP::Anime4KGPU :public Anime4K
@@ -22,26 +27,112 @@ public:
     Anime4KGPU(const Parameters& parameters = Parameters());
     virtual ~Anime4KGPU() = default;
     virtual void process() override;
-    static void initGPU(unsigned int platformID = 0, unsigned int deviceID = 0);
+    //deviceType may be CL_DEVICE_TYPE_CPU to run on a CPU OpenCL runtime like PoCL, mainly for testing
+    static void initGPU(unsigned int platformID = 0, unsigned int deviceID = 0, const cl_device_type type = CL_DEVICE_TYPE_GPU);
+    //open several devices as {platformID, deviceID}, from any platforms, every frame goes to the device
+    //expected to finish it first by the measured frame time of each device
+    static void initGPU(const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs, const cl_device_type type = CL_DEVICE_TYPE_GPU);
     static void releaseGPU();
     static bool isInitializedGPU();
-    static std::pair<std::pair<int, std::vector<int>>, std::string> listGPUs();
-    static std::pair<bool, std::string> checkGPUSupport(unsigned int pID, unsigned int dID);
+    static std::pair<std::pair<int, std::vector<int>>, std::string> listGPUs(const cl_device_type deviceType = CL_DEVICE_TYPE_GPU);
+    static std::pair<bool, std::string> checkGPUSupport(unsigned int pID, unsigned int dID, const cl_device_type deviceType = CL_DEVICE_TYPE_GPU);
+    //built programs are cached in dir, keyed by platform, device, driver and kernel source, so later runs skip
+    //compiling. The default is Anime4KCPP in the cache directory of the user, $XDG_CACHE_HOME, ~/.cache or
+    //%LOCALAPPDATA%. A dir others can write to or owned by another user is not used, an empty dir disables the cache
+    static void setProgramCacheDir(const std::string& dir);
+    //run every pass as one kernel on tiles in local memory (default), or as the separate pushColor, getGradient
+    //and pushGradient kernels, which are kept as the reference for it
+    static void setFusedKernel(const bool enable);
+    //on devices sharing memory with the host, let the device work on the 24 bit frames where they are instead
+    //of copying them to and from buffers of its own (default), false to always copy. Only frames that are
+    //continuous and page aligned can be used in place, like the ones of VideoIO::allocateFrame, others are copied
+    static void setZeroCopy(const bool enable);
 private:
+    //kernels and images for one runKernel call, cached by device and frame size so video frames don't
+    //create them again, every thread takes its own set as kernel arguments aren't thread-safe
+    struct KernelResources
+    {
+        size_t deviceIndex;
+        int orgW, orgH, W, H;
+        bool lanczos;
+        cl_command_queue queue = nullptr;
+        cl_kernel kernelGetGray = nullptr;
+        cl_kernel kernelPushColor = nullptr;
+        cl_kernel kernelGetGradient = nullptr;
+        cl_kernel kernelPushGradient = nullptr;
+        cl_kernel kernelPushColorGradient = nullptr;//nullptr if the device can't run it
+        cl_kernel kernelUnpackBGR = nullptr;
+        cl_kernel kernelPackBGR = nullptr;
+        cl_kernel kernelMedianBlur = nullptr;
+        cl_kernel kernelMeanBlur = nullptr;
+        cl_kernel kernelCASSharpening = nullptr;
+        cl_kernel kernelGaussianBlur = nullptr;
+        cl_kernel kernelBilateralFilter = nullptr;
+        cl_mem orgBGRBuffer = nullptr;
+        cl_mem dstBGRBuffer = nullptr;
+        cl_mem imageBuffer0 = nullptr;
+        cl_mem imageBuffer1 = nullptr;
+        cl_mem imageBuffer2 = nullptr;
+        cl_mem imageBuffer3 = nullptr;
+        cl_mem imageBuffer4 = nullptr;//second image of the original size, only created for preprocessing
+    };
+
+    //an opened device with its own context and program, and how busy and fast it is
+    struct Device
+    {
+        cl_device_id device = nullptr;
+        cl_context context = nullptr;
+        cl_program program = nullptr;
+        bool hostUnifiedMemory = false;
+        size_t hostPtrAlignment = VideoIO::frameAlignment;//of frames the device can use in place
+        int inFlight = 0;
+        double frameTime = 0.0;//moving average in seconds, 0 before the first frame
+    };
+
     void runKernel(cv::InputArray orgImg, cv::OutputArray dstImg);
-    static void initOpenCL();
+    static KernelResources acquireResources(const size_t deviceIndex,
+        const int orgW, const int orgH, const int W, const int H, const bool lanczos);
+    static void recycleResources(const KernelResources& res);
+    static void freeResources(const KernelResources& res);
+    //a buffer through which the device uses frame in place, nullptr if frame isn't aligned for it and has to be copied
+    static cl_mem wrapFrame(const Device& dev, const cl_mem_flags flags, const cv::Mat& frame);
+    //enqueue the filters in the order of FilterProcessor, ping-pong between img and tmpImg so img holds the result
+    static cl_int enqueueFilters(const KernelResources& res, const uint8_t filters, cl_mem& img, cl_mem& tmpImg, const size_t* size);
+    static void initOpenCL(const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs);
     static void releaseOpenCL();
+    static Device openDevice(const unsigned int pID, const unsigned int dID);
+    static void closeDevice(const Device& dev);
+    //pick the device for a frame and count it as busy, load is its frames in flight with this one
+    static size_t scheduleFrame(int& load);
+    //seconds < 0 for a failed frame, which isn't measured
+    static void finishFrame(const size_t deviceIndex, const int load, const double seconds);
+    static cl_command_queue createCommandQueue(cl_context context, cl_device_id device);
     static std::string readKernel(const std::string &fileName);
+    static cl_program buildProgram(cl_context context, cl_device_id device, const std::string& source);
+    static std::string getProgramCacheFile(cl_device_id device, const std::string& source);
+    static void saveProgramBinary(cl_program program, const std::string& cacheFile);
 private:
+    //Anime4KGPUCNN builds its programs and queues on the same devices and shares their scheduling
+    friend class Anime4KGPUCNN;
+    //the CLI times the resource cache and checks the filter kernels against FilterProcessor
+    friend class Benchmark;
+    friend class Verification;
+
     static bool isInitialized;
 
-    static cl_context context;
-    static cl_command_queue commandQueue;
-    static cl_program program;
-    static cl_device_id device;
+    static std::vector<Device> devices;
+    static std::mutex devicesMutex;
+    static cl_device_type deviceType;
+    static bool fusedKernel;
+    static bool zeroCopy;
+
+    static std::string programCacheDir;
+    static bool programCacheDirSet;
 
-    static unsigned int pID;
-    static unsigned int dID;
+    static std::mutex resourcesMutex;
+    static std::vector<KernelResources> resourcesCache;
+    //idle sets of a device are kept for up to this many frame sizes per thread
+    constexpr static size_t maxCachedSizes = 4;
 
     double nWidth;
     double nHeight;
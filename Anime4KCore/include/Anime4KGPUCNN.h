@@ -0,0 +1,60 @@
+#pragma once
+
+#include"Anime4KGPU.h"
+#include"Anime4KCPUCNN.h"
+
+namespace Anime4KCPP
+{
+    class DLL Anime4KGPUCNN;
+}
+
+//runs the model of Anime4KCPUCNN with OpenCL in float, on the devices of Anime4KGPU
+class Anime4KCPP::Anime4KGPUCNN :public Anime4K
+{
+public:
+    Anime4KGPUCNN(const Parameters& parameters = Parameters());
+    virtual ~Anime4KGPUCNN() = default;
+    virtual void process() override;
+    //initialize Anime4KGPU if needed and build the CNN program for its devices
+    static void initGPU(unsigned int platformID = 0, unsigned int deviceID = 0, const cl_device_type type = CL_DEVICE_TYPE_GPU);
+    static void releaseGPU();
+    static bool isInitializedGPU();
+private:
+    //kernels and buffers for one runKernel call, cached by device, frame size and model like Anime4KGPU does
+    struct KernelResources
+    {
+        size_t deviceIndex;
+        int width, height, srcStep;
+        std::shared_ptr<const Anime4KCPUCNN::Layers> layers;
+        cl_command_queue queue = nullptr;
+        cl_kernel kernelConvYToN = nullptr;
+        cl_kernel kernelConvNToN = nullptr;
+        cl_kernel kernelConvTransposeNTo1 = nullptr;
+        std::vector<cl_mem> kernelBuffers;
+        std::vector<cl_mem> biasBuffers;
+        cl_mem srcBuffer = nullptr;
+        cl_mem featureBuffers[2] = { nullptr, nullptr };
+        cl_mem dstBuffer = nullptr;
+    };
+
+    void runKernel(const cv::Mat& orgImg, cv::Mat& dstImg);
+    static KernelResources acquireResources(const size_t deviceIndex,
+        const int width, const int height, const int srcStep, const std::shared_ptr<const Anime4KCPUCNN::Layers>& layers);
+    static void recycleResources(const KernelResources& res);
+    static void freeResources(const KernelResources& res);
+    static void initOpenCL();
+    static void releaseOpenCL();
+private:
+    static bool isInitialized;
+
+    //one for each device of Anime4KGPU
+    static std::vector<cl_program> programs;
+
+    static std::mutex resourcesMutex;
+    static std::vector<KernelResources> resourcesCache;
+
+#ifdef BUILT_IN_KERNEL
+    static const std::string Anime4KCPPCNNKernelSourceString;
+#endif // BUILT_IN_KERNEL
+
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#ifdef ENABLE_LIBAV
+
+#include<opencv2/opencv.hpp>
+#include<cstdint>
+#include<string>
+#include<vector>
+
+//libav types are only used through pointers here, so users of the core don't need the libav headers
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVStream;
+struct AVFrame;
+struct AVPacket;
+struct SwsContext;
+
+namespace Anime4KCPP
+{
+    struct EncoderOptions;
+    class LibavReader;
+    class LibavWriter;
+}
+
+//decodes the best video stream of a file to BGR frames through libavformat and libavcodec,
+//with the part of the cv::VideoCapture interface VideoIO uses
+class Anime4KCPP::LibavReader
+{
+public:
+    LibavReader() = default;
+    ~LibavReader();
+    LibavReader(const LibavReader&) = delete;
+    LibavReader& operator=(const LibavReader&) = delete;
+    bool open(const std::string& srcFile);
+    bool isOpened() const;
+    //frame is reallocated only if its size or type doesn't match
+    bool read(cv::Mat& frame);
+    //CAP_PROP_FRAME_WIDTH, CAP_PROP_FRAME_HEIGHT, CAP_PROP_FPS, CAP_PROP_FRAME_COUNT, and as OpenCV
+    //CAP_PROP_POS_FRAMES for the index of the next frame and CAP_PROP_POS_MSEC for the timestamp of the last
+    //frame read, both from the stream start. 0 for others
+    double get(int propId) const;
+    //CAP_PROP_POS_FRAMES seeks to the keyframe before and drops the frames up to the one asked for
+    bool set(int propId, double value);
+    void release();
+private:
+    bool receiveFrame();
+private:
+    AVFormatContext* formatCtx = nullptr;
+    AVCodecContext* codecCtx = nullptr;
+    AVFrame* frame = nullptr;
+    AVPacket* packet = nullptr;
+    SwsContext* swsCtx = nullptr;
+    int streamIndex = -1;
+    double fps = 0.0;
+    double frameCount = 0.0;
+    int64_t skipUntil = INT64_MIN;//frames before this timestamp are dropped after a seek
+    double nextFrame = 0.0;
+    double position = 0.0;
+    bool draining = false;
+};
+
+//encodes BGR frames through libavcodec with the settings of EncoderOptions, and copies the audio
+//streams of another file into the same container as it goes, so no second pass is needed to add them
+class Anime4KCPP::LibavWriter
+{
+public:
+    LibavWriter() = default;
+    ~LibavWriter();
+    LibavWriter(const LibavWriter&) = delete;
+    LibavWriter& operator=(const LibavWriter&) = delete;
+    //encoder is the one of the codec asked for, the default one of the container is used if it isn't built
+    //in libavcodec, options.encoder overrides it and has no fallback. audioSrcFile is empty for no audio
+    bool open(const std::string& dstFile, const std::string& encoder, double fps, const cv::Size& size,
+        const EncoderOptions& options, const std::string& audioSrcFile = std::string());
+    bool isOpened() const;
+    //false if the frame or audio before it couldn't be encoded or written, then every later write fails too
+    bool write(const cv::Mat& frame);
+    //flush the encoder and the audio left, then finish the file, false if any of the file couldn't be written
+    bool release();
+private:
+    //add an output stream for every audio stream of the source the container may hold, false on an error
+    bool openAudio(const std::string& audioSrcFile);
+    //send frame to the encoder and write the packets it has ready, nullptr flushes it
+    bool encodeFrame(AVFrame* videoFrame);
+    //copy the audio packets up to time, in AV_TIME_BASE units, INT64_MAX for all left, false if the source
+    //can't be read or the muxer rejects a packet
+    bool copyAudio(int64_t time);
+private:
+    AVFormatContext* formatCtx = nullptr;
+    AVCodecContext* codecCtx = nullptr;
+    AVStream* stream = nullptr;
+    AVFrame* frame = nullptr;
+    AVPacket* packet = nullptr;
+    SwsContext* swsCtx = nullptr;
+    int64_t nextPts = 0;
+    bool opened = false;
+    bool failed = false;//a write failed, the file is incomplete
+
+    AVFormatContext* audioCtx = nullptr;
+    AVPacket* audioPacket = nullptr;
+    std::vector<int> audioStreams;//output stream of every input stream, -1 for the ones not copied
+    std::vector<int64_t> audioOffsets;//start of the source video in the time base of every input stream
+    bool audioPending = false;//audioPacket is read but not written yet
+};
+
+#endif // ENABLE_LIBAV
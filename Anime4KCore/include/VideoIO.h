@@ -2,15 +2,22 @@
 
 #include<opencv2/opencv.hpp>
 #include<atomic>
-#include<queue>
-#include<unordered_map>
+#include<fstream>
+#include<limits>
+#include<memory>
+#include<sstream>
 
+#include"dll.h"
 #include"threadpool.h"
+#include"ringbuffer.h"
+#include"LibavIO.h"
 
 namespace Anime4KCPP
 {
-    class VideoIO;
+    class DLL VideoIO;
     enum class CODEC;
+    enum class ParallelPolicy;
+    struct EncoderOptions;
     typedef std::pair<cv::Mat, size_t> Frame;
 }
 
@@ -19,6 +26,28 @@ enum class Anime4KCPP::CODEC
     OTHER = -1, MP4V = 0, DXVA = 1, AVC1 = 2, VP09 = 3, HEVC = 4, AV01 = 5
 };
 
+//how the threads of a video are split between frames in flight and the rows of each frame:
+//FRAME runs a frame on one thread each, ROW one frame at a time on all threads, MIXED about the
+//square root of threads for both, AUTO measures the other three on the first frames and keeps the fastest
+enum class Anime4KCPP::ParallelPolicy
+{
+    AUTO = 0, FRAME = 1, ROW = 2, MIXED = 3
+};
+
+//settings of the libav encoder, an empty or negative one is left to the encoder. Builds without
+//ENABLE_LIBAV write through cv::VideoWriter, which has none of them
+struct Anime4KCPP::EncoderOptions
+{
+    std::string encoder;//libav encoder like libx264, instead of the one of the codec given to openWriter
+    int64_t bitRate = -1;//bits per second
+    int crf = -1;
+    std::string preset;
+    std::string pixelFormat;//like yuv420p
+    int threads = 0;//0 for one per core
+    //copy the audio of the source into the output as it is written, for single file output only
+    bool copyAudio = false;
+};
+
 class Anime4KCPP::VideoIO
 {
 public:
@@ -26,27 +55,145 @@ public:
     VideoIO(const VideoIO&) = delete;
     VideoIO& operator=(const VideoIO&) = delete;
     static VideoIO& instance();
-    VideoIO& init(std::function<void()> &&p, size_t t);
+    VideoIO& init(std::function<void()> &&p, size_t t, ParallelPolicy pp = ParallelPolicy::AUTO);
     void process();
     bool openReader(const std::string& srcFile);
-    bool openWriter(const std::string& dstFile, CODEC codec, const cv::Size& size);
+    //with segments > 1 the video is cut into that many ranges of frames of about the same length, each one
+    //decoded by its own reader from a seek and encoded to its own file by getSegmentFiles, all of them at
+    //once. Every file starts with a keyframe of its own, so they can be concatenated without re-encoding.
+    //The cuts are at frame indices, so frames at them are only exact where the seek of the reader is, that is
+    //constant frame rate in indexed containers. A video without a frame count, or whose reader doesn't land
+    //on every cut exactly, is written as one segment, a range of the segments of it fails.
+    //checkpointFrames > 0 also starts a new file every that many frames of a segment. Finished files are
+    //recorded with their frames in the index file of the range of segments processed, which resume reads to skip them
+    bool openWriter(const std::string& dstFile, CODEC codec, const cv::Size& size, size_t segments = 1, size_t checkpointFrames = 0);
+    //only process the segments first to last - 1, to share a video between machines
+    void setSegmentRange(size_t first, size_t last);
+    //continue from the files in the index written before instead of starting over, set after openWriter.
+    //process() throws if the reader can't seek exactly to a checkpoint a segment continues from
+    void setResume(bool flag);
+    //files of the last process() in order, those resumed from included, empty if not in segment mode
+    std::vector<std::string> getSegmentFiles() const;
+    //index of the last process() in segment mode, dstFile.first-last.index for the segments first to last - 1
+    std::string getIndexFile() const;
+    //taken by the next openWriter
+    void setEncoderOptions(const EncoderOptions& options);
+    //true if this build can copy the audio through EncoderOptions::copyAudio
+    static bool canCopyAudio();
     double get(int p);
+    //throws if the writer couldn't finish the file
     void release();
     Frame read();
     void write(const Frame& frame);
+    //frame buffers for the decoder and processors, recycled once a frame is done with, so in steady state
+    //a video allocates nothing. They come from allocateFrame
+    cv::Mat acquireFrame(int rows, int cols, int type);
+    void recycleFrame(const cv::Mat& frame);
+    //a continuous frame, page aligned for 8 bit types, so OpenCL devices sharing memory with the host
+    //can work on it in place
+    static cv::Mat allocateFrame(int rows, int cols, int type);
+    constexpr static size_t frameAlignment = 4096;
+    //frame buffers allocated and taken from the pool by acquireFrame in the last process()
+    size_t getFrameAllocations() const;
+    size_t getFrameReuses() const;
+    //frames per second of every split run in the last process(), in the order they ran, for AUTO the
+    //tuning runs and then the one kept
+    const std::vector<std::pair<ParallelPolicy, double>>& getSplitThroughput() const;
+    //frames in flight and threads for the rows of each frame
+    static std::pair<size_t, size_t> getSplit(ParallelPolicy pp, size_t threads);
 private:
+#ifdef ENABLE_LIBAV
+    typedef LibavReader Reader;
+    typedef LibavWriter Writer;
+#else
+    typedef cv::VideoCapture Reader;
+    typedef cv::VideoWriter Writer;
+#endif
+
+    //frames begin to end - 1 written to file, end is the end of the segment for its last chunk
+    struct Chunk
+    {
+        size_t begin, end;
+        std::string file;
+    };
+
+    struct Segment
+    {
+        size_t begin, end;//range of frame index
+        size_t start;//first frame to decode, after the chunks resumed from
+        std::string name;//file name without extension
+        std::vector<std::string> files;
+        Reader reader;
+        Writer writer;
+        Chunk chunk;//the one being written, or written but not recorded yet
+        bool chunkPending = false;
+        const char* error = nullptr;
+        std::unique_ptr<ReorderRing<Frame>> reorderRing;
+        size_t frameCount = 0;
+        std::atomic<bool> decodeFinished{ false };
+    };
+
     VideoIO() = default;
+    void applySplit(ParallelPolicy pp);
+    void processSegments();
+    //decode frames begin to end - 1 of capture and hand them to processors, false if the seek to begin
+    //didn't land there, then nothing is decoded
+    bool decode(Reader& capture, size_t begin, size_t end, size_t& frameCount, std::atomic<bool>& decodeFinished);
+    //hand the frames of ring to encoder in order until all decoded are written. An encoder returning false
+    //stops the decoders, processors and encoders of every segment, the caller throws the error
+    void encode(ReorderRing<Frame>& ring, size_t& frameCount, std::atomic<bool>& decodeFinished,
+        const std::function<bool(Frame&)>& encoder);
+    //a processor threw or a frame couldn't be written, so the pipeline stops
+    bool stopped() const;
+    //write frame to the chunk files of segment, starting a new one every checkpointFrames, false with
+    //the error of segment set if the file can't be opened or written
+    bool encodeChunk(Segment& segment, Frame& frame);
+    void saveChunk(const Chunk& chunk);
+    std::vector<Chunk> loadIndex() const;
+    static bool openVideoReader(Reader& videoReader, const std::string& srcFile);
+    //seek videoReader to frame, false unless it says it is there
+    static bool seekVideoReader(Reader& videoReader, size_t frame);
+    //true if videoReader seeks to frame exactly, that is the frame read there has the timestamp of its index
+    //as well, or the video ends before it. Moves the position of videoReader
+    static bool checkCut(Reader& videoReader, size_t frame);
+    //audioSrcFile is empty for no audio
+    static bool openVideoWriter(Writer& videoWriter, const std::string& dstFile, CODEC codec, double fps, const cv::Size& size,
+        const EncoderOptions& options, const std::string& audioSrcFile);
+    //false if the frame or the end of the file couldn't be written, cv::VideoWriter reports neither
+    static bool writeVideoFrame(Writer& videoWriter, const cv::Mat& frame);
+    static bool releaseVideoWriter(Writer& videoWriter);
 private:
     size_t threads = 0;
+    ParallelPolicy policy = ParallelPolicy::AUTO;
+    std::atomic<size_t> frameThreads{ 0 };
+    std::atomic<size_t> inFlight{ 0 };
+    std::vector<std::pair<ParallelPolicy, double>> splitThroughput;
+    TaskGroup* processors = nullptr;
+
+    std::string srcPath, dstPath;
+    CODEC dstCodec = CODEC::MP4V;
+    cv::Size dstSize;
+    size_t segmentCount = 1, firstSegment = 0, lastSegment = 0;
+    size_t checkpointFrames = 0;
+    bool resume = false;
+    EncoderOptions encoderOptions;
+    std::string dstExtension;
+    std::string indexFile;
+    std::vector<std::unique_ptr<Segment>> segments;
+    std::mutex mtxIndex;
     std::function<void()> processor;
-    cv::VideoCapture reader;
-    cv::VideoWriter writer;
-    std::queue <Frame> rawFrames;
-    std::unordered_map<size_t, cv::Mat> frameMap;
-
-    std::mutex mtxRead;
-    std::condition_variable cndRead;
-    std::mutex mtxWrite;
-    std::condition_variable cndWrite;
+    Reader reader;
+    Writer writer;
+    std::unique_ptr<MPMCQueue<Frame>> rawFrames;
+    std::unique_ptr<ReorderRing<Frame>> reorderRing;
+    size_t frameCount = 0;//written by the decoder before decodeFinished
+    std::atomic<bool> decodeFinished{ false };
+    std::atomic<bool> encodeFailed{ false };
+
+    std::vector<cv::Mat> framePool;
+    size_t poolSize = 0;
+    std::mutex mtxPool;
+    std::atomic<size_t> frameAllocations{ 0 };
+    std::atomic<size_t> frameReuses{ 0 };
 };
 
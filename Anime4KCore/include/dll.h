@@ -0,0 +1,15 @@
+#pragma once
+
+//exported from the core library where a source defines DLL before its includes, imported everywhere else
+#ifdef _MSC_VER
+#ifndef DLL
+#define DLL __declspec(dllimport)
+#else
+#undef DLL
+#define DLL __declspec(dllexport)
+#endif
+#else
+#ifndef DLL
+#define DLL
+#endif
+#endif
@@ -2,11 +2,7 @@
 
 #include"Anime4K.h"
 
-#ifdef _MSC_VER
-#include<ppl.h>
-#else
-#include<omp.h>
-#endif
+#include"threadpool.h"
 
 #define MAX5(a, b, c, d, e) std::max({a, b, c, d, e})
 #define MIN5(a, b, c, d, e) std::min({a, b, c, d, e})
@@ -16,20 +12,40 @@
 
 namespace Anime4KCPP
 {
-    class FilterProcessor;
+    class DLL FilterProcessor;
 }
 
 class Anime4KCPP::FilterProcessor
 {
 public:
-    FilterProcessor(cv::InputArray srcImg, uint8_t _filters);
+    //tmp is an optional buffer of the same size and type as srcImg for the filters to write into
+    FilterProcessor(cv::InputArray srcImg, uint8_t _filters, const cv::Mat& tmp = cv::Mat());
     void process();
 private:
-    void CASSharpening(cv::InputArray src);
-    void changEachPixelBGR(cv::InputArray _src, const std::function<void(const int, const int, RGBA, Line)>&& callBack);
+    //the CLI times the per pixel loop
+    friend class Benchmark;
+
+    void CASSharpening(const cv::Mat& src, cv::Mat& dst);
+    template<typename F>
+    void changEachPixelBGR(const cv::Mat& src, cv::Mat& dst, F&& callBack);
 private:
     const static int B = 0, G = 1, R = 2, A = 3;
     int H, W;
     cv::Mat img, tmpImg;
     uint8_t filters;
 };
+
+template<typename F>
+inline void Anime4KCPP::FilterProcessor::changEachPixelBGR(const cv::Mat& src, cv::Mat& dst, F&& callBack)
+{
+    //every pixel of dst is written by callBack, so there is nothing to copy from src
+    dst.create(H, W, CV_8UC3);
+
+    int jMAX = W * 3;
+    ThreadPool::instance().parallelFor(0, H, [&](int i) {
+        Line lineData = src.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
+        Line tmpLineData = dst.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
+        for (int j = 0; j < jMAX; j += 3)
+            callBack(i, j, tmpLineData + j, lineData);
+        });
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<cstdint>
+#include<memory>
+#include<thread>
+
+//waits on a lock-free queue: yield first as most waits are short, then sleep longer and longer up to 1ms
+class Backoff
+{
+public:
+    void wait();
+private:
+    int count = 0;
+};
+
+//bounded queue for any number of producers and consumers, every slot carries a sequence number telling
+//if it is free for the push of that position or holds the value for the pop of that position
+template<typename T>
+class MPMCQueue
+{
+public:
+    MPMCQueue(size_t capacity);
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    //false if full
+    bool tryPush(T&& value);
+    //false if empty
+    bool tryPop(T& value);
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    const size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
+
+//slots for the values of index next to next + capacity - 1, put by any thread and taken in order by one
+template<typename T>
+class ReorderRing
+{
+public:
+    ReorderRing(size_t capacity);
+    ReorderRing(const ReorderRing&) = delete;
+    ReorderRing& operator=(const ReorderRing&) = delete;
+    //false if index is capacity or more ahead of next, every index must be put once
+    bool tryPut(size_t index, T&& value);
+    //false if the value of next isn't there yet
+    bool tryTake(T& value);
+    size_t next() const;
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;//index + 1 of the value it holds
+        T value;
+    };
+    const size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> nextIndex;
+};
+
+inline void Backoff::wait()
+{
+    if (count < 64)
+        std::this_thread::yield();
+    else
+        std::this_thread::sleep_for(std::chrono::microseconds(1 << std::min(count - 64, 10)));
+    count++;
+}
+
+template<typename T>
+inline MPMCQueue<T>::MPMCQueue(size_t capacity)
+    //with one slot a full and an empty one would have the same sequence
+    :capacity(std::max<size_t>(capacity, 2)), slots(new Slot[this->capacity]), head(0), tail(0)
+{
+    for (size_t i = 0; i < this->capacity; i++)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::tryPush(T&& value)
+{
+    size_t pos = head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot& slot = slots[pos % capacity];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.value = std::move(value);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)//the slot still holds the value of a lap before
+            return false;
+        else
+            pos = head.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::tryPop(T& value)
+{
+    size_t pos = tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot& slot = slots[pos % capacity];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0)
+        {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                value = std::move(slot.value);
+                slot.sequence.store(pos + capacity, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)//nothing pushed to the slot yet
+            return false;
+        else
+            pos = tail.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+inline ReorderRing<T>::ReorderRing(size_t capacity)
+    :capacity(capacity), slots(new Slot[capacity]), nextIndex(0)
+{
+    for (size_t i = 0; i < capacity; i++)
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+}
+
+template<typename T>
+inline bool ReorderRing<T>::tryPut(size_t index, T&& value)
+{
+    //the slot held index - capacity, which is taken once next is past it
+    if (index >= nextIndex.load(std::memory_order_acquire) + capacity)
+        return false;
+    Slot& slot = slots[index % capacity];
+    slot.value = std::move(value);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline bool ReorderRing<T>::tryTake(T& value)
+{
+    const size_t index = nextIndex.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % capacity];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+        return false;
+    value = std::move(slot.value);
+    nextIndex.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline size_t ReorderRing<T>::next() const
+{
+    return nextIndex.load(std::memory_order_acquire);
+}
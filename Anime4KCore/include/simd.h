@@ -0,0 +1,36 @@
+#pragma once
+
+#include<atomic>
+#include<cstdint>
+
+#include"dll.h"
+
+namespace Anime4KCPP
+{
+    namespace SIMD
+    {
+        enum class Level
+        {
+            NONE, SSE41, AVX2, NEON
+        };
+
+        //the level the kernels run at, the best the CPU supports unless setLevel chose another
+        DLL Level getLevel();
+        DLL const char* getLevelName(Level level = getLevel());
+        DLL bool isSupported(Level level);
+        //run the kernels at level from now on, NONE leaves every pixel to the scalar kernels.
+        //False if the CPU doesn't support level, then the level is kept
+        DLL bool setLevel(Level level);
+
+        //pushColor and pushGradient for count BGRA pixels, every pixel must have all 8 neighbours
+        //inside nLine/cLine/pLine, dst must hold a copy of cLine. Return how many pixels were done,
+        //the rest are left to the scalar kernel
+        int pushColorLine(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength);
+        int pushGradientLine(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength);
+
+        //3x3 conv with ReLU from 8 channels to 8 channels for count pixels of the CPU CNN, with the same neighbour
+        //rule as above, kernels are packed as [tap][input channel][output channel]. Return how many pixels were done
+        int conv8To8Line(float* dst, const float* nLine, const float* cLine, const float* pLine, int count, const float* kernels, const float* biases);
+        int conv8To8Line(double* dst, const double* nLine, const double* cLine, const double* pLine, int count, const double* kernels, const double* biases);
+    }
+}
@@ -1,47 +1,147 @@
 #pragma once
+#include<algorithm>
+#include<atomic>
 #include<thread>
 #include<mutex>
 #include<condition_variable>
+#include<deque>
+#include<exception>
 #include<functional>
-#include<queue>
+#include<future>
+#include<memory>
+#include<type_traits>
 #include<vector>
 
+#include"dll.h"
+#include"ringbuffer.h"
+
+//work-stealing pool: every worker has its own deque, it runs its newest task first and steals the oldest
+//task of another worker when it has none. Tasks of high priority go to a shared deque checked before all
 class ThreadPool
 {
 public:
+    enum class Priority
+    {
+        NORMAL, HIGH
+    };
+
     ThreadPool(size_t maxThreadCount);
     ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    //the pool shared by frame and row level parallelism, one worker for every hardware thread. It lives in
+    //the core library, so every module using the library drives the same workers
+    DLL static ThreadPool& instance();
+    size_t size() const;
     template<typename F>
-    void exec(F&& task);
+    void exec(F&& task, Priority priority = Priority::NORMAL);
+    template<typename F>
+    auto submit(F&& task, Priority priority = Priority::NORMAL)->std::future<std::invoke_result_t<std::decay_t<F>>>;
+    //queue all tasks of [first, last) and wake the workers once
+    template<typename It>
+    void execBatch(It first, It last, Priority priority = Priority::NORMAL);
+    //body(i) for every i in [begin, end), in chunks of grain indices (0 for about 4 chunks per worker).
+    //The caller runs chunks too and returns when all are done, the first exception of body is rethrown
+    template<typename F>
+    void parallelFor(int begin, int end, F&& body, int grain = 0);
+    //run one queued task on the calling thread, false if there was none
+    bool runPendingTask();
+    //threads a parallelFor runs on at most, the caller included, so frame level parallelism can leave
+    //the other workers to other frames. 1 runs loops on the caller alone, the default is size()
+    DLL void setLoopThreads(size_t count);
+    DLL size_t getLoopThreads() const;
+    //bind each worker to one of the CPUs the process may run on, round robin over its affinity mask or cpuset,
+    //false if the platform can't or a worker couldn't be bound
+    DLL bool pinWorkers();
 private:
+    struct Worker
+    {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mtx;
+    };
+
+    void push(std::function<void()>&& task, Priority priority);
+    bool pop(std::function<void()>& task);
+    void wake(bool all);
+    //index of the calling thread in this pool, size() for other threads
+    size_t workerIndex() const;
+private:
+    const size_t threadCount;
     std::vector<std::thread> threads;
-    std::queue<std::function<void()>> tasks;
+    std::unique_ptr<Worker[]> workers;
+    std::deque<std::function<void()>> highTasks;
+    std::mutex mtxHigh;
+    std::atomic<size_t> highCount;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> sleeping;
+    std::atomic<size_t> nextWorker;
+    std::atomic<size_t> loopThreads;
     std::condition_variable cnd;
     std::mutex mtx;
     bool stop;
+
+    //set by each worker when it starts
+    static thread_local const ThreadPool* currentPool;
+    static thread_local size_t currentIndex;
+};
+
+//tasks run on a pool that can be waited for as a whole
+class TaskGroup
+{
+public:
+    TaskGroup(ThreadPool& pool = ThreadPool::instance());
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    template<typename F>
+    void run(F&& task, ThreadPool::Priority priority = ThreadPool::Priority::NORMAL);
+    //wait for every task run so far and rethrow the first exception of them, the caller runs queued
+    //tasks of the pool meanwhile, so it is safe to wait on a worker
+    void wait();
+    //true once a task has thrown, so the ones feeding or waiting for the tasks can stop before wait()
+    bool failed() const;
+private:
+    struct State
+    {
+        std::atomic<size_t> pending{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr exception;
+        std::mutex mtx;
+    };
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
 };
 
+inline thread_local const ThreadPool* ThreadPool::currentPool = nullptr;
+inline thread_local size_t ThreadPool::currentIndex = 0;
+
 inline ThreadPool::ThreadPool(size_t maxThreadCount)
-    :stop(false)
+    :threadCount(std::max<size_t>(maxThreadCount, 1)), workers(new Worker[threadCount]),
+    highCount(0), pending(0), sleeping(0), nextWorker(0), loopThreads(threadCount), stop(false)
 {
-    for (int i = 0; i < maxThreadCount; i++)
-        threads.emplace_back([this]()
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        threads.emplace_back([this, i]()
             {
+                currentPool = this;
+                currentIndex = i;
                 for (;;)
                 {
                     std::function<void()> task;
+                    if (pop(task))
                     {
-                        std::unique_lock<std::mutex> lock(mtx);
-                        cnd.wait(lock, [this]
-                            {
-                                return stop || !tasks.empty();
-                            });
-                        if (stop && tasks.empty())
-                            return;
-                        task = std::move(tasks.front());
-                        tasks.pop();
+                        task();
+                        continue;
                     }
-                    task();
+                    std::unique_lock<std::mutex> lock(mtx);
+                    sleeping++;
+                    cnd.wait(lock, [this]
+                        {
+                            return stop || pending > 0;
+                        });
+                    sleeping--;
+                    if (stop && pending == 0)
+                        return;
                 }
             });
 }
@@ -56,12 +156,239 @@ inline ThreadPool::~ThreadPool()
     std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
 }
 
+inline size_t ThreadPool::size() const
+{
+    return threadCount;
+}
+
 template<typename F>
-void ThreadPool::exec(F&& f)
+void ThreadPool::exec(F&& task, Priority priority)
+{
+    push(std::function<void()>(std::forward<F>(task)), priority);
+    wake(false);
+}
+
+template<typename F>
+auto ThreadPool::submit(F&& task, Priority priority)->std::future<std::invoke_result_t<std::decay_t<F>>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto packagedTask = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+    std::future<R> ret = packagedTask->get_future();
+    exec([packagedTask]() { (*packagedTask)(); }, priority);
+    return ret;
+}
+
+template<typename It>
+void ThreadPool::execBatch(It first, It last, Priority priority)
+{
+    for (; first != last; ++first)
+        push(std::function<void()>(*first), priority);
+    wake(true);
+}
+
+template<typename F>
+void ThreadPool::parallelFor(int begin, int end, F&& body, int grain)
+{
+    const int count = end - begin;
+    if (count <= 0)
+        return;
+    const int threadsUsed = static_cast<int>(getLoopThreads());
+    if (grain <= 0)
+        grain = std::max(1, count / (threadsUsed * 4));
+    const int chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || threadsUsed == 1)
+    {
+        for (int i = begin; i < end; i++)
+            body(i);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<int> next{ 0 };
+        std::atomic<int> done{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>();
+    //a helper that starts after the loop is over finds no chunk left and never touches body
+    auto runChunks = [state, &body, begin, end, grain, chunks]()
+    {
+        for (int c; (c = state->next.fetch_add(1)) < chunks;)
+        {
+            const int first = begin + c * grain, last = std::min(first + grain, end);
+            try
+            {
+                for (int i = first; i < last; i++)
+                    body(i);
+            }
+            catch (...)
+            {
+                if (!state->failed.exchange(true))
+                    state->exception = std::current_exception();
+            }
+            state->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    //chunks of a frame already started come before new frames
+    const int helpers = std::min(chunks, threadsUsed) - 1;
+    for (int i = 0; i < helpers; i++)
+        push(runChunks, Priority::HIGH);
+    wake(true);
+    runChunks();
+    //every chunk is taken by now, the ones left are running on other threads
+    while (state->done.load(std::memory_order_acquire) < chunks)
+        std::this_thread::yield();
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+inline bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    if (!pop(task))
+        return false;
+    task();
+    return true;
+}
+
+inline void ThreadPool::push(std::function<void()>&& task, Priority priority)
+{
+    if (priority == Priority::HIGH)
+    {
+        std::lock_guard<std::mutex> lock(mtxHigh);
+        highTasks.push_back(std::move(task));
+        highCount++;
+    }
+    else
+    {
+        //workers push to their own deque, other threads spread tasks over all
+        size_t index = workerIndex();
+        if (index == size())
+            index = nextWorker++ % size();
+        std::lock_guard<std::mutex> lock(workers[index].mtx);
+        workers[index].tasks.push_back(std::move(task));
+    }
+    pending++;
+}
+
+inline bool ThreadPool::pop(std::function<void()>& task)
+{
+    if (highCount > 0)
+    {
+        std::lock_guard<std::mutex> lock(mtxHigh);
+        if (!highTasks.empty())
+        {
+            task = std::move(highTasks.front());
+            highTasks.pop_front();
+            highCount--;
+            pending--;
+            return true;
+        }
+    }
+    const size_t index = workerIndex();
+    if (index != size())
+    {
+        Worker& worker = workers[index];
+        std::lock_guard<std::mutex> lock(worker.mtx);
+        if (!worker.tasks.empty())
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            pending--;
+            return true;
+        }
+    }
+    //steal the oldest task of another worker
+    for (size_t i = 1; i <= size(); i++)
+    {
+        Worker& victim = workers[(index + i) % size()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending--;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void ThreadPool::wake(bool all)
 {
+    //pending is raised before sleeping is read, and sleeping before pending is checked under mtx,
+    //so a worker going to sleep either sees the task or gets notified
+    if (sleeping == 0)
+        return;
     {
         std::lock_guard<std::mutex> lock(mtx);
-        tasks.emplace(std::forward<F>(f));
     }
-    cnd.notify_one();
+    if (all)
+        cnd.notify_all();
+    else
+        cnd.notify_one();
+}
+
+inline size_t ThreadPool::workerIndex() const
+{
+    return currentPool == this ? currentIndex : threadCount;
+}
+
+inline TaskGroup::TaskGroup(ThreadPool& pool)
+    :pool(pool), state(std::make_shared<State>()) {}
+
+inline TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...) {}
+}
+
+template<typename F>
+void TaskGroup::run(F&& task, ThreadPool::Priority priority)
+{
+    state->pending++;
+    pool.exec([state = state, task = std::forward<F>(task)]() mutable
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mtx);
+                if (!state->exception)
+                    state->exception = std::current_exception();
+                state->failed.store(true, std::memory_order_release);
+            }
+            state->pending.fetch_sub(1, std::memory_order_release);
+        }, priority);
+}
+
+inline void TaskGroup::wait()
+{
+    for (Backoff backoff; state->pending.load(std::memory_order_acquire) > 0;)
+    {
+        if (pool.runPendingTask())
+            backoff = Backoff();
+        else
+            backoff.wait();
+    }
+    std::lock_guard<std::mutex> lock(state->mtx);
+    if (state->exception)
+    {
+        std::exception_ptr exception = state->exception;
+        state->exception = nullptr;
+        state->failed.store(false, std::memory_order_release);
+        std::rethrow_exception(exception);
+    }
+}
+
+inline bool TaskGroup::failed() const
+{
+    return state->failed.load(std::memory_order_acquire);
 }
@@ -16,6 +16,8 @@ Anime4KCPP::Anime4K::Anime4K(const Parameters& parameters)
     pref = parameters.preFilters;
     postf = parameters.postFilters;
     mt = parameters.maxThreads;
+    cnnp = parameters.cnnPrecision;
+    pp = parameters.parallelPolicy;
 
     orgH = orgW = H = W = 0;
     totalFrameCount = fps = 0.0;
@@ -41,6 +43,8 @@ void Anime4KCPP::Anime4K::setArguments(const Parameters& parameters)
     pref = parameters.preFilters;
     postf = parameters.postFilters;
     mt = parameters.maxThreads;
+    cnnp = parameters.cnnPrecision;
+    pp = parameters.parallelPolicy;
 
     orgH = orgW = H = W = 0;
     fps = 0.0;
@@ -111,9 +115,9 @@ void Anime4KCPP::Anime4K::loadImage(int rows, int cols, unsigned char* r, unsign
     W = zf * orgW;
 }
 
-void Anime4KCPP::Anime4K::setVideoSaveInfo(const std::string& dstFile, const CODEC codec)
+void Anime4KCPP::Anime4K::setVideoSaveInfo(const std::string& dstFile, const CODEC codec, const size_t segments, const size_t checkpointFrames)
 {
-    if(!VideoIO::instance().openWriter(dstFile, codec, cv::Size(W, H)))
+    if(!VideoIO::instance().openWriter(dstFile, codec, cv::Size(W, H), segments, checkpointFrames))
         throw "Failed to initialize video writer.";
 }
 
@@ -162,6 +166,8 @@ void Anime4KCPP::Anime4K::showInfo()
     {
         std::cout << "FPS: " << fps << std::endl;
         std::cout << "Threads: " << mt << std::endl;
+        std::cout << "Parallel policy: " << (pp == ParallelPolicy::FRAME ? "frame" :
+            pp == ParallelPolicy::ROW ? "row" : pp == ParallelPolicy::MIXED ? "mixed" : "auto") << std::endl;
         std::cout << "Total frames: " << totalFrameCount << std::endl;
     }
     std::cout << orgW << "x" << orgH << " to " << W << "x" << H << std::endl;
@@ -239,6 +245,8 @@ std::string Anime4KCPP::Anime4K::getInfo()
     {
         oss << "FPS: " << fps << std::endl;
         oss << "Threads: " << mt << std::endl;
+        oss << "Parallel policy: " << (pp == ParallelPolicy::FRAME ? "frame" :
+            pp == ParallelPolicy::ROW ? "row" : pp == ParallelPolicy::MIXED ? "mixed" : "auto") << std::endl;
         oss << "Total frames: " << totalFrameCount << std::endl;
     }
     oss << orgW << "x" << orgH << " to " << W << "x" << H << std::endl;
@@ -339,6 +347,8 @@ void Anime4KCPP::Parameters::reset()
     preFilters = 4;
     postFilters = 40;
     maxThreads = std::thread::hardware_concurrency();
+    cnnPrecision = CNNPrecision::DOUBLE;
+    parallelPolicy = ParallelPolicy::AUTO;
 }
 
 Anime4KCPP::Parameters::Parameters(
@@ -353,10 +363,13 @@ Anime4KCPP::Parameters::Parameters(
     bool postprocessing,
     uint8_t preFilters,
     uint8_t postFilters,
-    unsigned int maxThreads
+    unsigned int maxThreads,
+    CNNPrecision cnnPrecision,
+    ParallelPolicy parallelPolicy
 ) :
     passes(passes), pushColorCount(pushColorCount),
     strengthColor(strengthColor), strengthGradient(strengthGradient),
     zoomFactor(zoomFactor), fastMode(fastMode), videoMode(videoMode),
     preprocessing(preprocessing), postprocessing(postprocessing),
-    preFilters(preFilters), postFilters(postFilters), maxThreads(maxThreads) {}
+    preFilters(preFilters), postFilters(postFilters), maxThreads(maxThreads),
+    cnnPrecision(cnnPrecision), parallelPolicy(parallelPolicy) {}
@@ -2,14 +2,22 @@
 
 #include "Anime4KCPP.h"
 
-Anime4KCPP::Anime4KCreator::Anime4KCreator(bool initGPU, unsigned int platformID, unsigned int deviceID)
+Anime4KCPP::Anime4KCreator::Anime4KCreator(bool initGPU, unsigned int platformID, unsigned int deviceID, const cl_device_type deviceType)
 {
     if (initGPU && !Anime4KGPU::isInitializedGPU())
-        Anime4KGPU::initGPU(platformID, deviceID);
+        Anime4KGPU::initGPU(platformID, deviceID, deviceType);
+}
+
+Anime4KCPP::Anime4KCreator::Anime4KCreator(bool initGPU, const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs, const cl_device_type deviceType)
+{
+    if (initGPU && !Anime4KGPU::isInitializedGPU())
+        Anime4KGPU::initGPU(deviceIDs, deviceType);
 }
 
 Anime4KCPP::Anime4KCreator::~Anime4KCreator()
 {
+    if (Anime4KGPUCNN::isInitializedGPU())
+        Anime4KGPUCNN::releaseGPU();
     if (Anime4KGPU::isInitializedGPU())
         Anime4KGPU::releaseGPU();
 }
@@ -29,6 +37,12 @@ Anime4KCPP::Anime4K* Anime4KCPP::Anime4KCreator::create(
     case ProcessorType::CPUCNN:
         return new Anime4KCPUCNN(parameters);
         break;
+    case ProcessorType::GPUCNN:
+        //the CNN programs are only built when they are needed, on the devices Anime4KGPU uses
+        if (!Anime4KGPUCNN::isInitializedGPU())
+            Anime4KGPUCNN::initGPU();
+        return new Anime4KGPUCNN(parameters);
+        break;
     default:
         return nullptr;
         break;
@@ -0,0 +1,71 @@
+#pragma OPENCL FP_CONTRACT OFF
+
+#define RELU(x) fmax(x, 0.0f)
+
+//feature maps are float buffers of [y][x][channel], kernels are packed as [tap][input channel][output channel]
+//and summed in the same order as the CPU CNN, so float results match Anime4KCPUCNN
+__kernel void convYToN(
+    __global const uchar* src, const int srcStep,
+    __global float* dst,
+    const int width, const int height, const int channels,
+    __global const float* kernels, __global const float* biases)
+{
+    const int x = get_global_id(0), y = get_global_id(1), o = get_global_id(2);
+
+    //the second pixel takes itself as left neighbour
+    const int xs[3] = { x > 1 ? x - 1 : x, x, x < width - 1 ? x + 1 : x };
+    const int ys[3] = { y > 0 ? y - 1 : y, y, y < height - 1 ? y + 1 : y };
+
+    float sum = 0.0f;
+    for (int t = 0; t < 9; t++)
+    {
+        const float pixel = src[ys[t / 3] * srcStep + xs[t % 3] * 3] / 255.0f;
+        sum = t ? sum + pixel * kernels[t * channels + o] : pixel * kernels[o];
+    }
+    dst[(y * width + x) * channels + o] = RELU(sum + biases[o]);
+}
+
+__kernel void convNToN(
+    __global const float* src,
+    __global float* dst,
+    const int width, const int height, const int inChannels, const int outChannels,
+    __global const float* kernels, __global const float* biases)
+{
+    const int x = get_global_id(0), y = get_global_id(1), o = get_global_id(2);
+
+    const int xs[3] = { x > 1 ? x - 1 : x, x, x < width - 1 ? x + 1 : x };
+    const int ys[3] = { y > 0 ? y - 1 : y, y, y < height - 1 ? y + 1 : y };
+
+    float sum = 0.0f;
+    for (int c = 0; c < inChannels; c++)
+    {
+        float tmp = 0.0f;
+        for (int t = 0; t < 9; t++)
+        {
+            const float pixel = src[(ys[t / 3] * width + xs[t % 3]) * inChannels + c];
+            const float k = kernels[(t * inChannels + c) * outChannels + o];
+            tmp = t ? tmp + pixel * k : pixel * k;
+        }
+        sum = c ? sum + tmp : tmp;
+    }
+    dst[(y * width + x) * outChannels + o] = RELU(sum + biases[o]);
+}
+
+__kernel void convTransposeNTo1(
+    __global const float* src,
+    __global uchar* dst,
+    const int width, const int channels,
+    __global const float* kernels)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+
+    //every input pixel becomes 2x2 output pixels, each one takes its own tap of the 2x2 kernels
+    __global const float* pixel = src + ((y / 2) * width + x / 2) * channels;
+    __global const float* k = kernels + ((y % 2) * 2 + x % 2) * channels;
+
+    float tmp = pixel[0] * k[0];
+    for (int c = 1; c < channels; c++)
+        tmp = tmp + pixel[c] * k[c];
+    tmp = tmp * 255.0f;
+    dst[y * width * 2 + x] = tmp >= 255.0f ? 255 : (tmp <= 0.0f ? 0 : (uchar)tmp);
+}
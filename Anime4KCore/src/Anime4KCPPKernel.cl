@@ -277,4 +277,365 @@ __kernel void pushGradient(__read_only image2d_t srcImg, __write_only image2d_t
 
     mc.w = 0.299f * mc.z + 0.587f * mc.y + 0.114f * mc.x;
     write_imagef(dstImg, coord, mc);
+}
+//pushColor, getGradient and pushGradient of one pass in one kernel. Every work-group loads its tile with 3 pixels
+//around it into local memory and runs the three steps there. The steps keep 8 bit pixels in between and clamp
+//coordinates at the frame edges like the images of the separate kernels do, so both give the same result
+#define TILE_W 16
+#define TILE_H 8
+#define TILE_SIZE (TILE_W * TILE_H)
+
+inline static float4 loadPixel(__local const uchar4* buf, int stride, int x, int y)
+{
+    return convert_float4(buf[y * stride + x]) / 255.0f;
+}
+
+inline static uchar4 toPixel(float4 p)
+{
+    return convert_uchar4_sat_rte(p * 255.0f);
+}
+
+#define LOAD_NEIGHBOURS(buf, stride, x, y) \
+    float4 tl = loadPixel(buf, stride, x - 1, y - 1); \
+    float4 tc = loadPixel(buf, stride, x, y - 1); \
+    float4 tr = loadPixel(buf, stride, x + 1, y - 1); \
+    float4 ml = loadPixel(buf, stride, x - 1, y); \
+    float4 mc = loadPixel(buf, stride, x, y); \
+    float4 mr = loadPixel(buf, stride, x + 1, y); \
+    float4 bl = loadPixel(buf, stride, x - 1, y + 1); \
+    float4 bc = loadPixel(buf, stride, x, y + 1); \
+    float4 br = loadPixel(buf, stride, x + 1, y + 1)
+
+__kernel __attribute__((reqd_work_group_size(TILE_W, TILE_H, 1)))
+void pushColorGradient(__read_only image2d_t srcImg, __write_only image2d_t dstImg, float strengthColor, float strengthGradient, int enablePushColor)
+{
+    //the frame with 3 pixels of border first, then the gradient with 1
+    __local uchar4 bufA[(TILE_W + 6) * (TILE_H + 6)];
+    //pushColor with 2 pixels of border
+    __local uchar4 bufB[(TILE_W + 4) * (TILE_H + 4)];
+
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const int lid = get_local_id(1) * TILE_W + get_local_id(0);
+    const int x0 = get_group_id(0) * TILE_W, y0 = get_group_id(1) * TILE_H;
+
+    for (int i = lid; i < (TILE_W + 6) * (TILE_H + 6); i += TILE_SIZE)
+        bufA[i] = toPixel(read_imagef(srcImg, samplerN, (int2)(x0 - 3 + i % (TILE_W + 6), y0 - 3 + i / (TILE_W + 6))));
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    //a border pixel outside the frame takes the value of the nearest frame pixel, as a clamped image read would
+    for (int i = lid; i < (TILE_W + 4) * (TILE_H + 4); i += TILE_SIZE)
+    {
+        const int x = clamp(x0 - 2 + i % (TILE_W + 4), 0, width - 1) - (x0 - 3);
+        const int y = clamp(y0 - 2 + i / (TILE_W + 4), 0, height - 1) - (y0 - 3);
+        if (!enablePushColor)
+        {
+            bufB[i] = bufA[y * (TILE_W + 6) + x];
+            continue;
+        }
+
+        LOAD_NEIGHBOURS(bufA, TILE_W + 6, x, y);
+        float maxD,minL;
+
+        //top and bottom
+        maxD = MAX3(bl.w, bc.w, br.w);
+        minL = MIN3(tl.w, tc.w, tr.w);
+        if (minL > mc.w && mc.w > maxD)
+            getLightest(&mc, &tl, &tc, &tr, strengthColor);
+        else
+        {
+            maxD = MAX3(tl.w, tc.w, tr.w);
+            minL = MIN3(bl.w, bc.w, br.w);
+            if (minL > mc.w && mc.w > maxD)
+                getLightest(&mc, &bl, &bc, &br, strengthColor);
+        }
+
+        //sundiagonal
+        maxD = MAX3(ml.w, mc.w, bc.w);
+        minL = MIN3(tc.w, tr.w, mr.w);
+        if (minL > maxD)
+            getLightest(&mc, &tc, &tr, &mr, strengthColor);
+        else
+        {
+            maxD = MAX3(tc.w, mc.w, mr.w);
+            minL = MIN3(ml.w, bl.w, bc.w);
+            if (minL > maxD)
+                getLightest(&mc, &ml, &bl, &bc, strengthColor);
+        }
+
+        //left and right
+        maxD = MAX3(tl.w, ml.w, bl.w);
+        minL = MIN3(tr.w, mr.w, br.w);
+        if (minL > mc.w && mc.w > maxD)
+            getLightest(&mc, &tr, &mr, &br, strengthColor);
+        else
+        {
+            maxD = MAX3(tr.w, mr.w, br.w);
+            minL = MIN3(tl.w, ml.w, bl.w);
+            if (minL > mc.w && mc.w > maxD)
+                getLightest(&mc, &tl, &ml, &bl, strengthColor);
+        }
+
+        //diagonal
+        maxD = MAX3(tc.w, mc.w, ml.w);
+        minL = MIN3(mr.w, br.w, bc.w);
+        if (minL > maxD)
+            getLightest(&mc, &mr, &br, &bc, strengthColor);
+        else
+        {
+            maxD = MAX3(bc.w, mc.w, mr.w);
+            minL = MIN3(ml.w, tl.w, tc.w);
+            if (minL > maxD)
+                getLightest(&mc, &ml, &tl, &tc, strengthColor);
+        }
+
+        bufB[i] = toPixel(mc);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    //gradient with 1 pixel of border, bufA is free again
+    for (int i = lid; i < (TILE_W + 2) * (TILE_H + 2); i += TILE_SIZE)
+    {
+        const int x = clamp(x0 - 1 + i % (TILE_W + 2), 0, width - 1) - (x0 - 2);
+        const int y = clamp(y0 - 1 + i / (TILE_W + 2), 0, height - 1) - (y0 - 2);
+
+        LOAD_NEIGHBOURS(bufB, TILE_W + 4, x, y);
+
+        const float gradX = tr.w + mr.w + mr.w + br.w - tl.w - ml.w - ml.w - bl.w;
+        const float gradY = tl.w + tc.w + tc.w + tr.w - bl.w - bc.w - bc.w - br.w;
+
+        const float grad = clamp(native_sqrt(gradX * gradX + gradY * gradY), 0.0f, 1.0f);
+        mc.w = 1.0f - grad;
+
+        bufA[i] = toPixel(mc);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const int gx = x0 + get_local_id(0), gy = y0 + get_local_id(1);
+    if (gx >= width || gy >= height)
+        return;
+
+    const int2 coord = (int2)(gx, gy);
+    LOAD_NEIGHBOURS(bufA, TILE_W + 2, get_local_id(0) + 1, get_local_id(1) + 1);
+    float maxD,minL;
+
+    //top and bottom
+    maxD = MAX3(bl.w, bc.w, br.w);
+    minL = MIN3(tl.w, tc.w, tr.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tl, &tc, &tr, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tl.w, tc.w, tr.w);
+    minL = MIN3(bl.w, bc.w, br.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &bl, &bc, &br, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //sundiagonal
+    maxD = MAX3(ml.w, mc.w, bc.w);
+    minL = MIN3(tc.w, tr.w, mr.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &tc, &tr, &mr, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tc.w, mc.w, mr.w);
+    minL = MIN3(ml.w, bl.w, bc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &ml, &bl, &bc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //left and right
+    maxD = MAX3(tl.w, ml.w, bl.w);
+    minL = MIN3(tr.w, mr.w, br.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tr, &mr, &br, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tr.w, mr.w, br.w);
+    minL = MIN3(tl.w, ml.w, bl.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tl, &ml, &bl, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //diagonal
+    maxD = MAX3(tc.w, mc.w, ml.w);
+    minL = MIN3(mr.w, br.w, bc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &mr, &br, &bc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+    maxD = MAX3(bc.w, mc.w, mr.w);
+    minL = MIN3(ml.w, tl.w, tc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &ml, &tl, &tc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    mc.w = 0.299f * mc.z + 0.587f * mc.y + 0.114f * mc.x;
+    write_imagef(dstImg, coord, mc);
+}
+//frames go to the device and come back as packed 24 bit BGR, the images keep BGRA for the kernels above
+__kernel void unpackBGR(__global const uchar* src, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    __global const uchar* p = src + (y * get_image_width(dstImg) + x) * 3;
+    write_imagef(dstImg, (int2)(x, y), (float4)(p[0], p[1], p[2], 255.0f) / 255.0f);
+}
+
+__kernel void packBGR(__read_only image2d_t srcImg, __global uchar* dst)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const uchar4 p = convert_uchar4_sat_rte(read_imagef(srcImg, samplerN, (int2)(x, y)) * 255.0f);
+    __global uchar* q = dst + (y * get_image_width(srcImg) + x) * 3;
+    q[0] = p.x;
+    q[1] = p.y;
+    q[2] = p.z;
+}
+
+//pre and post filters of FilterProcessor, they work on 8 bit values like the CPU ones and leave alpha alone.
+//Borders follow OpenCV: replicated for medianBlur and reflected without the edge pixel for the others
+inline static float4 readByte(__read_only image2d_t img, int x, int y)
+{
+    return round(read_imagef(img, samplerN, (int2)(x, y)) * 255.0f);
+}
+
+inline static void writeByte(__write_only image2d_t img, int2 coord, float4 p)
+{
+    write_imagef(img, coord, round(clamp(p, 0.0f, 255.0f)) / 255.0f);
+}
+
+inline static int reflect101(int i, int size)
+{
+    return i < 0 ? -i : (i >= size ? 2 * size - 2 - i : i);
+}
+
+#define SORT2(a, b) { const float4 t = fmin(a, b); b = fmax(a, b); a = t; }
+
+__kernel void medianBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    float4 p0 = readByte(srcImg, x - 1, y - 1), p1 = readByte(srcImg, x, y - 1), p2 = readByte(srcImg, x + 1, y - 1);
+    float4 p3 = readByte(srcImg, x - 1, y), p4 = readByte(srcImg, x, y), p5 = readByte(srcImg, x + 1, y);
+    float4 p6 = readByte(srcImg, x - 1, y + 1), p7 = readByte(srcImg, x, y + 1), p8 = readByte(srcImg, x + 1, y + 1);
+    const float alpha = p4.w;
+
+    //median of 9 with 19 compare-exchanges, for all channels at once
+    SORT2(p1, p2); SORT2(p4, p5); SORT2(p7, p8);
+    SORT2(p0, p1); SORT2(p3, p4); SORT2(p6, p7);
+    SORT2(p1, p2); SORT2(p4, p5); SORT2(p7, p8);
+    SORT2(p0, p3); SORT2(p5, p8); SORT2(p4, p7);
+    SORT2(p3, p6); SORT2(p1, p4); SORT2(p2, p5);
+    SORT2(p4, p7); SORT2(p4, p2); SORT2(p6, p4);
+    SORT2(p4, p2);
+
+    p4.w = alpha;
+    writeByte(dstImg, (int2)(x, y), p4);
+}
+
+__kernel void meanBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+
+    float4 sum = (float4)(0.0f);
+    for (int j = -1; j <= 1; j++)
+        for (int i = -1; i <= 1; i++)
+            sum += readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+
+    float4 p = sum / 9.0f;
+    p.w = readByte(srcImg, x, y).w;
+    writeByte(dstImg, (int2)(x, y), p);
+}
+
+//CAS of FilterProcessor, the second pixel takes itself as left neighbour like the CPU one does
+__kernel void casSharpening(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+
+    const float4 tc = readByte(srcImg, x, y > 0 ? y - 1 : y);
+    const float4 ml = readByte(srcImg, x > 1 ? x - 1 : x, y);
+    const float4 mc = readByte(srcImg, x, y);
+    const float4 mr = readByte(srcImg, x < width - 1 ? x + 1 : x, y);
+    const float4 bc = readByte(srcImg, x, y < height - 1 ? y + 1 : y);
+
+    const float4 minC = fmin(fmin(fmin(tc, ml), fmin(mc, mr)), bc);
+    const float4 maxC = fmax(fmax(fmax(tc, ml), fmax(mc, mr)), bc);
+
+    const float peak = -0.2f;
+    const float4 w = peak * sqrt(fmin(minC, 255.0f - maxC) * (1.0f / fmax(maxC, 1.0f)));
+
+    float4 p = (w * (tc + ml + mr + bc) + mc) / (1.0f + 4.0f * w);
+    p.w = mc.w;
+    writeByte(dstImg, (int2)(x, y), floor(clamp(p, 0.0f, 255.0f) + 0.5f));
+}
+
+//3x3 Gaussian with the weights of cv::getGaussianKernel for the sigma, side for the neighbours
+__kernel void gaussianBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg, float side, float center)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const float k[3] = { side, center, side };
+
+    float4 sum = (float4)(0.0f);
+    for (int j = -1; j <= 1; j++)
+    {
+        float4 line = (float4)(0.0f);
+        for (int i = -1; i <= 1; i++)
+            line += k[i + 1] * readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+        sum += k[j + 1] * line;
+    }
+
+    sum.w = readByte(srcImg, x, y).w;
+    writeByte(dstImg, (int2)(x, y), sum);
+}
+
+//cv::bilateralFilter for 3 channels: a round window of radius, the color distance is the sum of the channel differences
+__kernel void bilateralFilter(__read_only image2d_t srcImg, __write_only image2d_t dstImg, int radius, float spaceCoeff, float colorCoeff)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const float4 mc = readByte(srcImg, x, y);
+
+    float4 sum = (float4)(0.0f);
+    float weightSum = 0.0f;
+    for (int j = -radius; j <= radius; j++)
+        for (int i = -radius; i <= radius; i++)
+        {
+            const int r2 = i * i + j * j;
+            if (r2 > radius * radius)
+                continue;
+            const float4 p = readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+            const float4 d = fabs(p - mc);
+            const float diff = d.x + d.y + d.z;
+            const float weight = exp(r2 * spaceCoeff) * exp(diff * diff * colorCoeff);
+            sum += p * weight;
+            weightSum += weight;
+        }
+
+    float4 p = sum / weightSum;
+    p.w = mc.w;
+    writeByte(dstImg, (int2)(x, y), p);
 }
\ No newline at end of file
@@ -17,13 +17,25 @@ void Anime4KCPP::Anime4KCPU::process()
         if (pre)
             FilterProcessor(dstImg, pref).process();
         cv::cvtColor(dstImg, dstImg, cv::COLOR_BGR2BGRA);
-        for (int i = 0; i < ps; i++)
+        tmpImg.create(H, W, CV_8UC4);
+        if (!fm)
         {
-            getGray(dstImg);
-            if (sc && (tmpPcc-- > 0))
-                pushColor(dstImg);
-            getGradient(dstImg);
-            pushGradient(dstImg);
+            for (int i = 0; i < ps; i++)
+            {
+                runFusedPass(dstImg, tmpImg, sc && (tmpPcc-- > 0));
+                cv::swap(dstImg, tmpImg);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < ps; i++)
+            {
+                getGray(dstImg);
+                if (sc && (tmpPcc-- > 0))
+                    pushColor(dstImg, tmpImg);
+                getGradient(dstImg, tmpImg);
+                pushGradient(dstImg, tmpImg);
+            }
         }
         cv::cvtColor(dstImg, dstImg, cv::COLOR_BGRA2BGR);
         if (post)//PostProcessing
@@ -34,136 +46,93 @@ void Anime4KCPP::Anime4KCPU::process()
         VideoIO::instance().init(
             [this]()
             {
-                Frame frame = VideoIO::instance().read();
+                VideoIO& videoIO = VideoIO::instance();
+                Frame frame = videoIO.read();
+                //every buffer comes from the frame pool and goes back to it, the output after it's written
                 cv::Mat orgFrame = frame.first;
-                cv::Mat dstFrame(H, W, CV_8UC4);
+                cv::Mat orgBGRA = videoIO.acquireFrame(orgH, orgW, CV_8UC4);
+                cv::Mat dstFrame = videoIO.acquireFrame(H, W, CV_8UC4);
+                cv::Mat tmpFrame = videoIO.acquireFrame(H, W, CV_8UC4);
+                cv::Mat outFrame = videoIO.acquireFrame(H, W, CV_8UC3);
+                cv::Mat preFrame, postFrame;
                 int tmpPcc = this->pcc;
                 if (pre)
-                    FilterProcessor(orgFrame, pref).process();
-                cv::cvtColor(orgFrame, orgFrame, cv::COLOR_BGR2BGRA);
+                {
+                    preFrame = videoIO.acquireFrame(orgH, orgW, CV_8UC3);
+                    FilterProcessor(orgFrame, pref, preFrame).process();
+                }
+                cv::cvtColor(orgFrame, orgBGRA, cv::COLOR_BGR2BGRA);
                 if (zf == 2.0F)
-                    cv::resize(orgFrame, dstFrame, cv::Size(0, 0), zf, zf, cv::INTER_LINEAR);
+                    cv::resize(orgBGRA, dstFrame, cv::Size(0, 0), zf, zf, cv::INTER_LINEAR);
+                else
+                    cv::resize(orgBGRA, dstFrame, cv::Size(0, 0), zf, zf, cv::INTER_CUBIC);
+                if (!fm)
+                {
+                    for (int i = 0; i < ps; i++)
+                    {
+                        runFusedPass(dstFrame, tmpFrame, sc && (tmpPcc-- > 0));
+                        cv::swap(dstFrame, tmpFrame);
+                    }
+                }
                 else
-                    cv::resize(orgFrame, dstFrame, cv::Size(0, 0), zf, zf, cv::INTER_CUBIC);
-                for (int i = 0; i < ps; i++)
                 {
-                    getGray(dstFrame);
-                    if (sc && (tmpPcc-- > 0))
-                        pushColor(dstFrame);
-                    getGradient(dstFrame);
-                    pushGradient(dstFrame);
+                    for (int i = 0; i < ps; i++)
+                    {
+                        getGray(dstFrame);
+                        if (sc && (tmpPcc-- > 0))
+                            pushColor(dstFrame, tmpFrame);
+                        getGradient(dstFrame, tmpFrame);
+                        pushGradient(dstFrame, tmpFrame);
+                    }
                 }
-                cv::cvtColor(dstFrame, dstFrame, cv::COLOR_BGRA2BGR);
+                cv::cvtColor(dstFrame, outFrame, cv::COLOR_BGRA2BGR);
                 if (post)//PostProcessing
-                    FilterProcessor(dstFrame, postf).process();
-                frame.first = dstFrame;
-                VideoIO::instance().write(frame);
+                {
+                    postFrame = videoIO.acquireFrame(H, W, CV_8UC3);
+                    FilterProcessor(outFrame, postf, postFrame).process();
+                }
+                for (const cv::Mat& buffer : { orgFrame, orgBGRA, dstFrame, tmpFrame, preFrame, postFrame })
+                    videoIO.recycleFrame(buffer);
+                frame.first = outFrame;
+                videoIO.write(frame);
             }
-        , mt
+        , mt, pp
             ).process();
     }
 }
 
-inline void Anime4KCPP::Anime4KCPU::getGray(cv::InputArray img)
+inline void Anime4KCPP::Anime4KCPU::getGray(cv::Mat& img)
 {
-    changEachPixelBGRA(img, [](const int i, const int j, RGBA pixel, Line curLine) {
-        pixel[A] = (pixel[R] >> 2) + (pixel[R] >> 4) + (pixel[G] >> 1) + (pixel[G] >> 4) + (pixel[B] >> 3);
+    //getGray only touches the current pixel, so it works in place
+    changEachPixelBGRA(img, img, [&](const int /*i*/, const int /*j*/, RGBA pixel, Line /*curLine*/) {
+        getGrayKernel(pixel);
         });
 }
 
-inline void Anime4KCPP::Anime4KCPU::pushColor(cv::InputArray img)
+inline void Anime4KCPP::Anime4KCPU::pushColor(cv::Mat& img, cv::Mat& tmp)
 {
     const int lineStep = W * 4;
-    changEachPixelBGRA(img, [&](const int i, const int j, RGBA pixel, Line curLine) {
-        const int jp = j < (W - 1) * 4 ? 4 : 0;
-        const int jn = j > 4 ? -4 : 0;
+    changEachLineBGRA(img, tmp, [&](const int i, Line dstLine, Line curLine) {
         const Line pLineData = i < H - 1 ? curLine + lineStep : curLine;
         const Line cLineData = curLine;
         const Line nLineData = i > 0 ? curLine - lineStep : curLine;
 
-        const RGBA tl = nLineData + j + jn, tc = nLineData + j, tr = nLineData + j + jp;
-        const RGBA ml = cLineData + j + jn, mc = pixel, mr = cLineData + j + jp;
-        const RGBA bl = pLineData + j + jn, bc = pLineData + j, br = pLineData + j + jp;
-
-        uint8_t maxD, minL;
-
-        //top and bottom
-        maxD = MAX3(bl[A], bc[A], br[A]);
-        minL = MIN3(tl[A], tc[A], tr[A]);
-        if (minL > mc[A] && mc[A] > maxD)
-            getLightest(mc, tl, tc, tr);
-        else
-        {
-            maxD = MAX3(tl[A], tc[A], tr[A]);
-            minL = MIN3(bl[A], bc[A], br[A]);
-            if (minL > mc[A] && mc[A] > maxD)
-                getLightest(mc, bl, bc, br);
-        }
-
-        //sundiagonal
-        maxD = MAX3(ml[A], mc[A], bc[A]);
-        minL = MIN3(tc[A], tr[A], mr[A]);
-        if (minL > maxD)
-            getLightest(mc, tc, tr, mr);
-        else
-        {
-            maxD = MAX3(tc[A], mc[A], mr[A]);
-            minL = MIN3(ml[A], bl[A], bc[A]);
-            if (minL > maxD)
-                getLightest(mc, ml, bl, bc);
-        }
-
-        //left and right
-        maxD = MAX3(tl[A], ml[A], bl[A]);
-        minL = MIN3(tr[A], mr[A], br[A]);
-        if (minL > mc[A] && mc[A] > maxD)
-            getLightest(mc, tr, mr, br);
-        else
-        {
-            maxD = MAX3(tr[A], mr[A], br[A]);
-            minL = MIN3(tl[A], ml[A], bl[A]);
-            if (minL > mc[A] && mc[A] > maxD)
-                getLightest(mc, tl, ml, bl);
-        }
-
-        //diagonal
-        maxD = MAX3(tc[A], mc[A], ml[A]);
-        minL = MIN3(mr[A], br[A], bc[A]);
-        if (minL > maxD)
-            getLightest(mc, mr, br, bc);
-        else
-        {
-            maxD = MAX3(bc[A], mc[A], mr[A]);
-            minL = MIN3(ml[A], tl[A], tc[A]);
-            if (minL > maxD)
-                getLightest(mc, ml, tl, tc);
-        }
+        pushColorLine(dstLine, nLineData, cLineData, pLineData);
         });
+    cv::swap(img, tmp);
 }
 
-inline void Anime4KCPP::Anime4KCPU::getGradient(cv::InputArray img)
+inline void Anime4KCPP::Anime4KCPU::getGradient(cv::Mat& img, cv::Mat& tmp)
 {
     if (!fm)
     {
         const int lineStep = W * 4;
-        changEachPixelBGRA(img, [&](const int i, const int j, RGBA pixel, Line curLine) {
-            if (i == 0 || j == 0 || i == H - 1 || j == (W - 1) * 4)
+        changEachPixelBGRA(img, tmp, [&](const int i, const int j, RGBA pixel, Line curLine) {
+            if (i == 0 || i == H - 1)
                 return;
-            const Line pLineData = curLine + lineStep;
-            const Line cLineData = curLine;
-            const Line nLineData = curLine - lineStep;
-            const int jp = 4, jn = -4;
-
-            int gradX =
-                (pLineData + j + jn)[A] + (pLineData + j)[A] + (pLineData + j)[A] + (pLineData + j + jp)[A] -
-                (nLineData + j + jn)[A] - (nLineData + j)[A] - (nLineData + j)[A] - (nLineData + j + jp)[A];
-            int gradY =
-                (nLineData + j + jn)[A] + (cLineData + j + jn)[A] + (cLineData + j + jn)[A] + (pLineData + j + jn)[A] -
-                (nLineData + j + jp)[A] - (cLineData + j + jp)[A] - (cLineData + j + jp)[A] - (pLineData + j + jp)[A];
-            float Grad = sqrt(gradX * gradX + gradY * gradY);
-
-            pixel[A] = 255 - UNFLOAT(Grad);
+            getGradientKernel(i, j, pixel, curLine - lineStep, curLine, curLine + lineStep);
             });
+        cv::swap(img, tmp);
     }
     else
     {
@@ -180,102 +149,273 @@ inline void Anime4KCPP::Anime4KCPU::getGradient(cv::InputArray img)
         cv::addWeighted(gradX, 0.5, gradY, 0.5, 0, alpha);
 
         int fromTo_set[] = { 0,A };
-        cv::mixChannels(255 - alpha, img.getMat(), fromTo_set, 1);
+        cv::mixChannels(255 - alpha, img, fromTo_set, 1);
     }
 }
 
-inline void Anime4KCPP::Anime4KCPU::pushGradient(cv::InputArray img)
+inline void Anime4KCPP::Anime4KCPU::pushGradient(cv::Mat& img, cv::Mat& tmp)
 {
     const int lineStep = W * 4;
-    changEachPixelBGRA(img, [&](const int i, const int j, RGBA pixel, Line curLine) {
-        const int jp = j < (W - 1) * 4 ? 4 : 0;
-        const int jn = j > 4 ? -4 : 0;
-
+    changEachLineBGRA(img, tmp, [&](const int i, Line dstLine, Line curLine) {
         const Line pLineData = i < H - 1 ? curLine + lineStep : curLine;
         const Line cLineData = curLine;
         const Line nLineData = i > 0 ? curLine - lineStep : curLine;
 
-        const RGBA tl = nLineData + j + jn, tc = nLineData + j, tr = nLineData + j + jp;
-        const RGBA ml = cLineData + j + jn, mc = pixel, mr = cLineData + j + jp;
-        const RGBA bl = pLineData + j + jn, bc = pLineData + j, br = pLineData + j + jp;
+        pushGradientLine(dstLine, nLineData, cLineData, pLineData);
+        });
+    cv::swap(img, tmp);
+}
 
-        uint8_t maxD, minL;
+void Anime4KCPP::Anime4KCPU::runFusedPass(const cv::Mat& src, cv::Mat& dst, const bool pushColorFlag)
+{
+    //a frame run by one thread is a single band, with no halo lines to compute twice
+    ThreadPool& pool = ThreadPool::instance();
+    const int loopThreads = static_cast<int>(pool.getLoopThreads());
+    const int bandHeight = std::max(minBandHeight, loopThreads == 1 ? H : H / (4 * loopThreads));
+    const int bands = (H + bandHeight - 1) / bandHeight;
+    pool.parallelFor(0, bands, [&](int b) {
+        processBand(src, dst, b * bandHeight, std::min(H, (b + 1) * bandHeight), pushColorFlag);
+        }, 1);
+}
 
-        //top and bottom
-        maxD = MAX3(bl[A], bc[A], br[A]);
-        minL = MIN3(tl[A], tc[A], tr[A]);
-        if (minL > mc[A] && mc[A] > maxD)
-            return getAverage(mc, tl, tc, tr);
+void Anime4KCPP::Anime4KCPU::processBand(const cv::Mat& src, cv::Mat& dst, const int begin, const int end, const bool pushColorFlag)
+{
+    const size_t lineSize = static_cast<size_t>(W) * static_cast<size_t>(4);
+    //one stage lags one line behind the previous one,
+    //so three lines for each stage are enough to hold all neighbours
+    std::vector<unsigned char> window(lineSize * 9);
+    Line grayLines[3], colorLines[3], gradientLines[3];
+    for (int k = 0; k < 3; k++)
+    {
+        grayLines[k] = window.data() + lineSize * k;
+        colorLines[k] = pushColorFlag ? window.data() + lineSize * (k + 3) : grayLines[k];
+        gradientLines[k] = window.data() + lineSize * (k + 6);
+    }
+
+    const int colorLag = pushColorFlag ? 1 : 0;
+    const int halo = colorLag + 2;
+    for (int k = begin - halo; k < end + halo; k++)
+    {
+        //getGray
+        if (k >= 0 && k < H)
+        {
+            Line grayLine = grayLines[k % 3];
+            memcpy(grayLine, src.data + static_cast<size_t>(k) * lineSize, lineSize);
+            for (size_t j = 0; j < lineSize; j += 4)
+                getGrayKernel(grayLine + j);
+        }
+        //pushColor
+        const int c = k - colorLag;
+        if (pushColorFlag && c >= 0 && c < H && c >= begin - 2 && c < end + 2)
+        {
+            const Line nLineData = grayLines[(c > 0 ? c - 1 : c) % 3];
+            const Line cLineData = grayLines[c % 3];
+            const Line pLineData = grayLines[(c < H - 1 ? c + 1 : c) % 3];
+            Line colorLine = colorLines[c % 3];
+            memcpy(colorLine, cLineData, lineSize);
+            pushColorLine(colorLine, nLineData, cLineData, pLineData);
+        }
+        //getGradient
+        const int g = c - 1;
+        if (g >= 0 && g < H && g >= begin - 1 && g < end + 1)
+        {
+            const Line cLineData = colorLines[g % 3];
+            Line gradientLine = gradientLines[g % 3];
+            memcpy(gradientLine, cLineData, lineSize);
+            if (g != 0 && g != H - 1)
+            {
+                const Line nLineData = colorLines[(g - 1) % 3];
+                const Line pLineData = colorLines[(g + 1) % 3];
+                for (int j = 0; j < static_cast<int>(lineSize); j += 4)
+                    getGradientKernel(g, j, gradientLine + j, nLineData, cLineData, pLineData);
+            }
+        }
+        //pushGradient
+        const int p = g - 1;
+        if (p >= begin && p < end)
+        {
+            const Line nLineData = gradientLines[(p > 0 ? p - 1 : p) % 3];
+            const Line cLineData = gradientLines[p % 3];
+            const Line pLineData = gradientLines[(p < H - 1 ? p + 1 : p) % 3];
+            Line dstLine = dst.data + static_cast<size_t>(p) * lineSize;
+            memcpy(dstLine, cLineData, lineSize);
+            pushGradientLine(dstLine, nLineData, cLineData, pLineData);
+        }
+    }
+}
+
+inline void Anime4KCPP::Anime4KCPU::getGrayKernel(RGBA mc)
+{
+    mc[A] = (mc[R] >> 2) + (mc[R] >> 4) + (mc[G] >> 1) + (mc[G] >> 4) + (mc[B] >> 3);
+}
+
+inline void Anime4KCPP::Anime4KCPU::pushColorKernel(const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData)
+{
+    const int jp = j < (W - 1) * 4 ? 4 : 0;
+    const int jn = j > 4 ? -4 : 0;
 
+    const RGBA tl = nLineData + j + jn, tc = nLineData + j, tr = nLineData + j + jp;
+    const RGBA ml = cLineData + j + jn, mr = cLineData + j + jp;
+    const RGBA bl = pLineData + j + jn, bc = pLineData + j, br = pLineData + j + jp;
+
+    uint8_t maxD, minL;
+
+    //top and bottom
+    maxD = MAX3(bl[A], bc[A], br[A]);
+    minL = MIN3(tl[A], tc[A], tr[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        getLightest(mc, tl, tc, tr);
+    else
+    {
         maxD = MAX3(tl[A], tc[A], tr[A]);
         minL = MIN3(bl[A], bc[A], br[A]);
         if (minL > mc[A] && mc[A] > maxD)
-            return getAverage(mc, bl, bc, br);
-
-        //sundiagonal
-        maxD = MAX3(ml[A], mc[A], bc[A]);
-        minL = MIN3(tc[A], tr[A], mr[A]);
-        if (minL > maxD)
-            return getAverage(mc, tc, tr, mr);
+            getLightest(mc, bl, bc, br);
+    }
 
+    //sundiagonal
+    maxD = MAX3(ml[A], mc[A], bc[A]);
+    minL = MIN3(tc[A], tr[A], mr[A]);
+    if (minL > maxD)
+        getLightest(mc, tc, tr, mr);
+    else
+    {
         maxD = MAX3(tc[A], mc[A], mr[A]);
         minL = MIN3(ml[A], bl[A], bc[A]);
         if (minL > maxD)
-            return getAverage(mc, ml, bl, bc);
-
-        //left and right
-        maxD = MAX3(tl[A], ml[A], bl[A]);
-        minL = MIN3(tr[A], mr[A], br[A]);
-        if (minL > mc[A] && mc[A] > maxD)
-            return getAverage(mc, tr, mr, br);
+            getLightest(mc, ml, bl, bc);
+    }
 
+    //left and right
+    maxD = MAX3(tl[A], ml[A], bl[A]);
+    minL = MIN3(tr[A], mr[A], br[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        getLightest(mc, tr, mr, br);
+    else
+    {
         maxD = MAX3(tr[A], mr[A], br[A]);
         minL = MIN3(tl[A], ml[A], bl[A]);
         if (minL > mc[A] && mc[A] > maxD)
-            return getAverage(mc, tl, ml, bl);
-
-        //diagonal
-        maxD = MAX3(tc[A], mc[A], ml[A]);
-        minL = MIN3(mr[A], br[A], bc[A]);
-        if (minL > maxD)
-            return getAverage(mc, mr, br, bc);
+            getLightest(mc, tl, ml, bl);
+    }
 
+    //diagonal
+    maxD = MAX3(tc[A], mc[A], ml[A]);
+    minL = MIN3(mr[A], br[A], bc[A]);
+    if (minL > maxD)
+        getLightest(mc, mr, br, bc);
+    else
+    {
         maxD = MAX3(bc[A], mc[A], mr[A]);
         minL = MIN3(ml[A], tl[A], tc[A]);
         if (minL > maxD)
-            return getAverage(mc, ml, tl, tc);
+            getLightest(mc, ml, tl, tc);
+    }
+}
 
-        pixel[A] = 255;
-        });
+inline void Anime4KCPP::Anime4KCPU::getGradientKernel(const int /*i*/, const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData)
+{
+    if (j == 0 || j == (W - 1) * 4)
+        return;
+    const int jp = 4, jn = -4;
+
+    int gradX =
+        (pLineData + j + jn)[A] + (pLineData + j)[A] + (pLineData + j)[A] + (pLineData + j + jp)[A] -
+        (nLineData + j + jn)[A] - (nLineData + j)[A] - (nLineData + j)[A] - (nLineData + j + jp)[A];
+    int gradY =
+        (nLineData + j + jn)[A] + (cLineData + j + jn)[A] + (cLineData + j + jn)[A] + (pLineData + j + jn)[A] -
+        (nLineData + j + jp)[A] - (cLineData + j + jp)[A] - (cLineData + j + jp)[A] - (pLineData + j + jp)[A];
+    float Grad = sqrt(gradX * gradX + gradY * gradY);
+
+    mc[A] = 255 - UNFLOAT(Grad);
 }
 
-inline void Anime4KCPP::Anime4KCPU::changEachPixelBGRA(cv::InputArray _src,
-    const std::function<void(const int, const int, RGBA, Line)>&& callBack)
+inline void Anime4KCPP::Anime4KCPU::pushGradientKernel(const int j, RGBA mc, const Line nLineData, const Line cLineData, const Line pLineData)
 {
-    cv::Mat src = _src.getMat();
-    cv::Mat tmp;
-    src.copyTo(tmp);
-
-    int jMAX = W * 4;
-#ifdef _MSC_VER //let's do something crazy
-    Concurrency::parallel_for(0, H, [&](int i) {
-        Line lineData = src.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(4);
-        Line tmpLineData = tmp.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(4);
-        for (int j = 0; j < jMAX; j += 4)
-            callBack(i, j, tmpLineData + j, lineData);
-        });
-#else //for gcc and others
-#pragma omp parallel for
-    for (int i = 0; i < H; i++)
+    const int jp = j < (W - 1) * 4 ? 4 : 0;
+    const int jn = j > 4 ? -4 : 0;
+
+    const RGBA tl = nLineData + j + jn, tc = nLineData + j, tr = nLineData + j + jp;
+    const RGBA ml = cLineData + j + jn, mr = cLineData + j + jp;
+    const RGBA bl = pLineData + j + jn, bc = pLineData + j, br = pLineData + j + jp;
+
+    uint8_t maxD, minL;
+
+    //top and bottom
+    maxD = MAX3(bl[A], bc[A], br[A]);
+    minL = MIN3(tl[A], tc[A], tr[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        return getAverage(mc, tl, tc, tr);
+
+    maxD = MAX3(tl[A], tc[A], tr[A]);
+    minL = MIN3(bl[A], bc[A], br[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        return getAverage(mc, bl, bc, br);
+
+    //sundiagonal
+    maxD = MAX3(ml[A], mc[A], bc[A]);
+    minL = MIN3(tc[A], tr[A], mr[A]);
+    if (minL > maxD)
+        return getAverage(mc, tc, tr, mr);
+
+    maxD = MAX3(tc[A], mc[A], mr[A]);
+    minL = MIN3(ml[A], bl[A], bc[A]);
+    if (minL > maxD)
+        return getAverage(mc, ml, bl, bc);
+
+    //left and right
+    maxD = MAX3(tl[A], ml[A], bl[A]);
+    minL = MIN3(tr[A], mr[A], br[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        return getAverage(mc, tr, mr, br);
+
+    maxD = MAX3(tr[A], mr[A], br[A]);
+    minL = MIN3(tl[A], ml[A], bl[A]);
+    if (minL > mc[A] && mc[A] > maxD)
+        return getAverage(mc, tl, ml, bl);
+
+    //diagonal
+    maxD = MAX3(tc[A], mc[A], ml[A]);
+    minL = MIN3(mr[A], br[A], bc[A]);
+    if (minL > maxD)
+        return getAverage(mc, mr, br, bc);
+
+    maxD = MAX3(bc[A], mc[A], mr[A]);
+    minL = MIN3(ml[A], tl[A], tc[A]);
+    if (minL > maxD)
+        return getAverage(mc, ml, tl, tc);
+
+    mc[A] = 255;
+}
+
+inline void Anime4KCPP::Anime4KCPU::pushColorLine(Line dstLine, const Line nLineData, const Line cLineData, const Line pLineData)
+{
+    //the first two pixels and the last one clamp their neighbours, they always go to the scalar kernel,
+    //SIMD takes the middle of the line and the scalar kernel finishes whatever is left
+    const int jMAX = W * 4;
+    int j = 0;
+    if (W > 3)
     {
-        Line lineData = src.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(4);
-        Line tmpLineData = tmp.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(4);
-        for (int j = 0; j < jMAX; j += 4)
-            callBack(i, j, tmpLineData + j, lineData);
+        pushColorKernel(0, dstLine, nLineData, cLineData, pLineData);
+        pushColorKernel(4, dstLine + 4, nLineData, cLineData, pLineData);
+        j = 8 + 4 * SIMD::pushColorLine(dstLine + 8, nLineData + 8, cLineData + 8, pLineData + 8, W - 3, sc);
     }
-#endif //something crazy
+    for (; j < jMAX; j += 4)
+        pushColorKernel(j, dstLine + j, nLineData, cLineData, pLineData);
+}
 
-    tmp.copyTo(src);
+inline void Anime4KCPP::Anime4KCPU::pushGradientLine(Line dstLine, const Line nLineData, const Line cLineData, const Line pLineData)
+{
+    const int jMAX = W * 4;
+    int j = 0;
+    if (W > 3)
+    {
+        pushGradientKernel(0, dstLine, nLineData, cLineData, pLineData);
+        pushGradientKernel(4, dstLine + 4, nLineData, cLineData, pLineData);
+        j = 8 + 4 * SIMD::pushGradientLine(dstLine + 8, nLineData + 8, cLineData + 8, pLineData + 8, W - 3, sg);
+    }
+    for (; j < jMAX; j += 4)
+        pushGradientKernel(j, dstLine + j, nLineData, cLineData, pLineData);
 }
 
 inline void Anime4KCPP::Anime4KCPU::getLightest(RGBA mc, const RGBA a, const RGBA b, const RGBA c)
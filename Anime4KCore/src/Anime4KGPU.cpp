@@ -1,6 +1,15 @@
 #define DLL
 
 #include "Anime4KGPU.h"
+#include "Anime4KGPUCNN.h"
+
+#include<cerrno>
+#include<cstdlib>
+
+#ifndef _WIN32
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
 
 Anime4KCPP::Anime4KGPU::Anime4KGPU(const Parameters& parameters) :
     Anime4K(parameters),
@@ -21,45 +30,43 @@ void Anime4KCPP::Anime4KGPU::process()
 
     if (!vm)
     {
-        dstImg.create(H, W, CV_8UC4);
-        if (pre)//Pretprocessing(CPU)
-            FilterProcessor(orgImg, pref).process();
-        cv::cvtColor(orgImg, orgImg, cv::COLOR_BGR2BGRA);
+        //aligned, so a device sharing memory with the host writes it in place
+        dstImg = VideoIO::allocateFrame(H, W, CV_8UC3);
+        //pre and post processing run on the device in runKernel
         runKernel(orgImg, dstImg);
-        cv::cvtColor(dstImg, dstImg, cv::COLOR_BGRA2BGR);
-        if (post)//Postprocessing(CPU)
-            FilterProcessor(dstImg, postf).process();
     }
     else
     {
         VideoIO::instance().init(
             [this]()
             {
-                Frame frame = VideoIO::instance().read();
+                VideoIO& videoIO = VideoIO::instance();
+                Frame frame = videoIO.read();
                 cv::Mat orgFrame = frame.first;
-                cv::Mat dstFrame(H, W, CV_8UC4);
-                if (pre)
-                    FilterProcessor(orgFrame, pref).process();
-                cv::cvtColor(orgFrame, orgFrame, cv::COLOR_BGR2BGRA);
+                cv::Mat dstFrame = videoIO.acquireFrame(H, W, CV_8UC3);
                 runKernel(orgFrame, dstFrame);
-                cv::cvtColor(dstFrame, dstFrame, cv::COLOR_BGRA2BGR);
-                if (post)//PostProcessing
-                    FilterProcessor(dstFrame, postf).process();
+                videoIO.recycleFrame(orgFrame);
                 frame.first = dstFrame;
-                VideoIO::instance().write(frame);
+                videoIO.write(frame);
             }
-            , mt
+            , mt, pp
                 ).process();
     }
 }
 
-void Anime4KCPP::Anime4KGPU::initGPU(unsigned int platformID, unsigned int deviceID)
+void Anime4KCPP::Anime4KGPU::initGPU(unsigned int platformID, unsigned int deviceID, const cl_device_type type)
+{
+    initGPU(std::vector<std::pair<unsigned int, unsigned int>>{ { platformID, deviceID } }, type);
+}
+
+void Anime4KCPP::Anime4KGPU::initGPU(const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs, const cl_device_type type)
 {
     if (!isInitialized)
     {
-        pID = platformID;
-        dID = deviceID;
-        initOpenCL();
+        if (deviceIDs.empty())
+            throw"No OpenCL device specified";
+        deviceType = type;
+        initOpenCL(deviceIDs);
         isInitialized = true;
     }
 }
@@ -68,11 +75,15 @@ void Anime4KCPP::Anime4KGPU::releaseGPU()
 {
     if (isInitialized)
     {
+        //the CNN programs live in the same contexts
+        Anime4KGPUCNN::releaseGPU();
+        {
+            std::lock_guard<std::mutex> lock(resourcesMutex);
+            for (const KernelResources& res : resourcesCache)
+                freeResources(res);
+            resourcesCache.clear();
+        }
         releaseOpenCL();
-        context = nullptr;
-        commandQueue = nullptr;
-        program = nullptr;
-        device = nullptr;
         isInitialized = false;
     }
 }
@@ -82,7 +93,7 @@ bool Anime4KCPP::Anime4KGPU::isInitializedGPU()
     return isInitialized;
 }
 
-std::pair<std::pair<int, std::vector<int>>, std::string> Anime4KCPP::Anime4KGPU::listGPUs()
+std::pair<std::pair<int, std::vector<int>>, std::string> Anime4KCPP::Anime4KGPU::listGPUs(const cl_device_type deviceType)
 {
     cl_int err = 0;
     cl_uint platforms = 0;
@@ -133,7 +144,7 @@ std::pair<std::pair<int, std::vector<int>>, std::string> Anime4KCPP::Anime4KGPU:
 
         delete[] platformName;
 
-        err = clGetDeviceIDs(platform[i], CL_DEVICE_TYPE_GPU, 0, nullptr, &devices);
+        err = clGetDeviceIDs(platform[i], deviceType, 0, nullptr, &devices);
         if (err != CL_SUCCESS || !devices)
         {
             delete[] platform;
@@ -143,7 +154,7 @@ std::pair<std::pair<int, std::vector<int>>, std::string> Anime4KCPP::Anime4KGPU:
         devicesVector.push_back(devices);
 
         device = new cl_device_id[devices];
-        err = clGetDeviceIDs(platform[i], CL_DEVICE_TYPE_GPU, devices, device, nullptr);
+        err = clGetDeviceIDs(platform[i], deviceType, devices, device, nullptr);
         if (err != CL_SUCCESS)
         {
             delete[] device;
@@ -188,7 +199,7 @@ std::pair<std::pair<int, std::vector<int>>, std::string> Anime4KCPP::Anime4KGPU:
     return ret;
 }
 
-std::pair<bool, std::string> Anime4KCPP::Anime4KGPU::checkGPUSupport(unsigned int pID, unsigned int dID)
+std::pair<bool, std::string> Anime4KCPP::Anime4KGPU::checkGPUSupport(unsigned int pID, unsigned int dID, const cl_device_type deviceType)
 {
     cl_int err = 0;
     cl_uint platforms = 0;
@@ -234,7 +245,7 @@ std::pair<bool, std::string> Anime4KCPP::Anime4KGPU::checkGPUSupport(unsigned in
     }
 
 
-    err = clGetDeviceIDs(firstPlatform, CL_DEVICE_TYPE_GPU, 0, nullptr, &devices);
+    err = clGetDeviceIDs(firstPlatform, deviceType, 0, nullptr, &devices);
     if (err != CL_SUCCESS || !devices)
     {
         delete[] platformName;
@@ -242,7 +253,7 @@ std::pair<bool, std::string> Anime4KCPP::Anime4KGPU::checkGPUSupport(unsigned in
     }
 
     cl_device_id* tmpDevice = new cl_device_id[devices];
-    err = clGetDeviceIDs(firstPlatform, CL_DEVICE_TYPE_GPU, devices, tmpDevice, nullptr);
+    err = clGetDeviceIDs(firstPlatform, deviceType, devices, tmpDevice, nullptr);
     if (err != CL_SUCCESS)
     {
         delete[] platformName;
@@ -291,10 +302,11 @@ void Anime4KCPP::Anime4KGPU::runKernel(cv::InputArray orgImg, cv::OutputArray ds
     cl_int err;
     int i;
 
-    const size_t orgin[3] = { 0,0,0 };
-    const size_t orgRegion[3] = { size_t(orgW),size_t(orgH),1 };
-    const size_t dstRegion[3] = { size_t(W),size_t(H),1 };
+    const size_t orgSize[2] = { size_t(orgW),size_t(orgH) };
     const size_t size[2] = { size_t(W),size_t(H) };
+    //pushColorGradient works on tiles of 16x8 pixels
+    const size_t tileSize[2] = { 16,8 };
+    const size_t tiledSize[2] = { (size_t(W) + 15) / 16 * 16,(size_t(H) + 7) / 8 * 8 };
 
     const cl_float pushColorStrength = sc;
     const cl_float pushGradientStrength = sg;
@@ -304,6 +316,319 @@ void Anime4KCPP::Anime4KGPU::runKernel(cv::InputArray orgImg, cv::OutputArray ds
     cv::Mat orgImage = orgImg.getMat();
     cv::Mat dstImage = dstImg.getMat();
 
+    //frames go to the device expected to finish them first
+    int load = 0;
+    const size_t deviceIndex = scheduleFrame(load);
+    const auto start = std::chrono::steady_clock::now();
+
+    //kernels and images are reused by later frames of the same size
+    KernelResources res;
+    try
+    {
+        res = acquireResources(deviceIndex, orgW, orgH, W, H, zf != 2.0F);
+    }
+    catch (...)
+    {
+        finishFrame(deviceIndex, load, -1.0);
+        throw;
+    }
+
+    //the frame goes up as 24 bit BGR and is unpacked to BGRA on the device. A device sharing memory with the
+    //host works on aligned frames where they are, others are copied to and from the buffers of the set.
+    //The wrapping buffers are released however the frame ends, after the failure paths finish the queue
+    if (!orgImage.isContinuous())
+        orgImage = orgImage.clone();
+    cv::Mat dstBGR = dstImage.isContinuous() ? dstImage : cv::Mat(H, W, CV_8UC3);
+    struct HostBuffers
+    {
+        cl_mem org = nullptr, dst = nullptr;
+        ~HostBuffers()
+        {
+            if (org != nullptr)
+                clReleaseMemObject(org);
+            if (dst != nullptr)
+                clReleaseMemObject(dst);
+        }
+    } hostBuffers;
+    if (zeroCopy && devices[deviceIndex].hostUnifiedMemory)
+    {
+        hostBuffers.org = wrapFrame(devices[deviceIndex], CL_MEM_READ_ONLY, orgImage);
+        hostBuffers.dst = wrapFrame(devices[deviceIndex], CL_MEM_WRITE_ONLY, dstBGR);
+    }
+    cl_mem orgBGRBuffer = hostBuffers.org != nullptr ? hostBuffers.org : res.orgBGRBuffer;
+    cl_mem dstBGRBuffer = hostBuffers.dst != nullptr ? hostBuffers.dst : res.dstBGRBuffer;
+
+    //set arguments
+    //getGray
+    err = clSetKernelArg(res.kernelGetGray, 0, sizeof(cl_mem), &res.imageBuffer0);
+    err |= clSetKernelArg(res.kernelGetGray, 1, sizeof(cl_mem), &res.imageBuffer1);
+    err |= clSetKernelArg(res.kernelGetGray, 2, sizeof(cl_float), &normalizedWidth);
+    err |= clSetKernelArg(res.kernelGetGray, 3, sizeof(cl_float), &normalizedHeight);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"getGray clSetKernelArg error";
+    }
+    //pushColor
+    err = clSetKernelArg(res.kernelPushColor, 0, sizeof(cl_mem), &res.imageBuffer1);
+    err |= clSetKernelArg(res.kernelPushColor, 1, sizeof(cl_mem), &res.imageBuffer2);
+    err |= clSetKernelArg(res.kernelPushColor, 2, sizeof(cl_float), &pushColorStrength);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"pushColor clSetKernelArg error";
+    }
+    //getGradient
+    err = clSetKernelArg(res.kernelGetGradient, 0, sizeof(cl_mem), &res.imageBuffer2);
+    err |= clSetKernelArg(res.kernelGetGradient, 1, sizeof(cl_mem), &res.imageBuffer3);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"getGradient clSetKernelArg error";
+    }
+    //pushGradient
+    err = clSetKernelArg(res.kernelPushGradient, 0, sizeof(cl_mem), &res.imageBuffer3);
+    err |= clSetKernelArg(res.kernelPushGradient, 1, sizeof(cl_mem), &res.imageBuffer1);
+    err |= clSetKernelArg(res.kernelPushGradient, 2, sizeof(cl_float), &pushGradientStrength);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"pushGradient clSetKernelArg error";
+    }
+    //unpackBGR and packBGR
+    err = clSetKernelArg(res.kernelUnpackBGR, 0, sizeof(cl_mem), &orgBGRBuffer);
+    err |= clSetKernelArg(res.kernelUnpackBGR, 1, sizeof(cl_mem), &res.imageBuffer0);
+    err |= clSetKernelArg(res.kernelPackBGR, 1, sizeof(cl_mem), &dstBGRBuffer);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"BGR clSetKernelArg error";
+    }
+
+    //enqueue
+    //a wrapped frame is already where the device reads it
+    if (hostBuffers.org == nullptr)
+    {
+        err = clEnqueueWriteBuffer(res.queue, res.orgBGRBuffer, CL_FALSE, 0, orgImage.total() * 3, orgImage.data, 0, nullptr, nullptr);
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"Failed to write orgBGRBuffer";
+        }
+    }
+    err = clEnqueueNDRangeKernel(res.queue, res.kernelUnpackBGR, 2, nullptr, orgSize, nullptr, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+    {
+        clFinish(res.queue);
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"unpackBGR error";
+    }
+    if (pre)//Pretprocessing(device)
+    {
+        cl_mem orgBuffer = res.imageBuffer0;
+        if (res.imageBuffer4 == nullptr)
+        {
+            cl_image_format format;
+            format.image_channel_data_type = CL_UNORM_INT8;
+            format.image_channel_order = CL_RGBA;
+            cl_image_desc orgDesc{};
+            orgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+            orgDesc.image_height = orgH;
+            orgDesc.image_width = orgW;
+            res.imageBuffer4 = clCreateImage(devices[deviceIndex].context, CL_MEM_READ_WRITE, &format, &orgDesc, nullptr, &err);
+            if (err != CL_SUCCESS)
+            {
+                res.imageBuffer4 = nullptr;
+                clFinish(res.queue);
+                freeResources(res);
+                finishFrame(deviceIndex, load, -1.0);
+                throw"imageBuffer4 error";
+            }
+        }
+        cl_mem tmpBuffer = res.imageBuffer4;
+        err = enqueueFilters(res, pref, orgBuffer, tmpBuffer, orgSize);
+        err |= clSetKernelArg(res.kernelGetGray, 0, sizeof(cl_mem), &orgBuffer);
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"Preprocessing error";
+        }
+    }
+    err = clEnqueueNDRangeKernel(res.queue, res.kernelGetGray, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+    {
+        clFinish(res.queue);
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"getGray error";
+    }
+    cl_mem resultBuffer = res.imageBuffer1;
+    if (fusedKernel && res.kernelPushColorGradient != nullptr)
+    {
+        //one kernel for each pass, ping-pong between imageBuffer1 and imageBuffer2
+        cl_mem srcBuffer = res.imageBuffer1, dstBuffer = res.imageBuffer2;
+        err = clSetKernelArg(res.kernelPushColorGradient, 2, sizeof(cl_float), &pushColorStrength);
+        err |= clSetKernelArg(res.kernelPushColorGradient, 3, sizeof(cl_float), &pushGradientStrength);
+        for (i = 0; i < ps; i++)
+        {
+            const cl_int enablePushColor = i < pcc;
+            err |= clSetKernelArg(res.kernelPushColorGradient, 0, sizeof(cl_mem), &srcBuffer);
+            err |= clSetKernelArg(res.kernelPushColorGradient, 1, sizeof(cl_mem), &dstBuffer);
+            err |= clSetKernelArg(res.kernelPushColorGradient, 4, sizeof(cl_int), &enablePushColor);
+            err |= clEnqueueNDRangeKernel(res.queue, res.kernelPushColorGradient, 2, nullptr, tiledSize, tileSize, 0, nullptr, nullptr);
+            std::swap(srcBuffer, dstBuffer);
+        }
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"pushColorGradient error";
+        }
+        resultBuffer = srcBuffer;
+    }
+    else
+    {
+        err = CL_SUCCESS;
+        for (i = 0; i < ps && i < pcc; i++)//pcc for push color count
+        {
+            err |= clEnqueueNDRangeKernel(res.queue, res.kernelPushColor, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+            err |= clEnqueueNDRangeKernel(res.queue, res.kernelGetGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+            err |= clEnqueueNDRangeKernel(res.queue, res.kernelPushGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+        }
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"pushColor error";
+        }
+        if (i < ps)
+        {
+            //reset getGradient
+            err = clSetKernelArg(res.kernelGetGradient, 0, sizeof(cl_mem), &res.imageBuffer1);
+            err |= clSetKernelArg(res.kernelGetGradient, 1, sizeof(cl_mem), &res.imageBuffer2);
+            if (err != CL_SUCCESS)
+            {
+                //the non-blocking write may still read orgImage
+                clFinish(res.queue);
+                freeResources(res);
+                finishFrame(deviceIndex, load, -1.0);
+                throw"Reset getGradient clSetKernelArg error";
+            }
+            //reset pushGradient
+            err = clSetKernelArg(res.kernelPushGradient, 0, sizeof(cl_mem), &res.imageBuffer2);
+            err |= clSetKernelArg(res.kernelPushGradient, 1, sizeof(cl_mem), &res.imageBuffer1);
+            err |= clSetKernelArg(res.kernelPushGradient, 2, sizeof(cl_float), &pushGradientStrength);
+            if (err != CL_SUCCESS)
+            {
+                //the non-blocking write may still read orgImage
+                clFinish(res.queue);
+                freeResources(res);
+                finishFrame(deviceIndex, load, -1.0);
+                throw"Reset pushGradient clSetKernelArg error";
+            }
+
+            while (i++ < ps)
+            {
+                err |= clEnqueueNDRangeKernel(res.queue, res.kernelGetGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+                err |= clEnqueueNDRangeKernel(res.queue, res.kernelPushGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+            }
+            if (err != CL_SUCCESS)
+            {
+                clFinish(res.queue);
+                freeResources(res);
+                finishFrame(deviceIndex, load, -1.0);
+                throw"pushGradient error";
+            }
+        }
+    }
+    if (post)//Postprocessing(device), imageBuffer3 is free after the passes
+    {
+        cl_mem tmpBuffer = res.imageBuffer3;
+        err = enqueueFilters(res, postf, resultBuffer, tmpBuffer, size);
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"Postprocessing error";
+        }
+    }
+    //and comes back packed to 24 bit BGR
+    err = clSetKernelArg(res.kernelPackBGR, 0, sizeof(cl_mem), &resultBuffer);
+    err |= clEnqueueNDRangeKernel(res.queue, res.kernelPackBGR, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+    {
+        clFinish(res.queue);
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"packBGR error";
+    }
+    if (hostBuffers.dst != nullptr)
+    {
+        //mapping a buffer of the frame itself copies nothing, it waits for packBGR and makes its output visible
+        void* data = clEnqueueMapBuffer(res.queue, hostBuffers.dst, CL_TRUE, CL_MAP_READ, 0, dstBGR.total() * 3, 0, nullptr, nullptr, &err);
+        if (err != CL_SUCCESS)
+        {
+            clFinish(res.queue);
+            freeResources(res);
+            finishFrame(deviceIndex, load, -1.0);
+            throw"Failed to map dstBGRBuffer";
+        }
+        err = clEnqueueUnmapMemObject(res.queue, hostBuffers.dst, data, 0, nullptr, nullptr);
+        err |= clFinish(res.queue);
+    }
+    else
+    {
+        //blocking read
+        err = clEnqueueReadBuffer(res.queue, res.dstBGRBuffer, CL_TRUE, 0, dstBGR.total() * 3, dstBGR.data, 0, nullptr, nullptr);
+    }
+    if (err != CL_SUCCESS)
+    {
+        clFinish(res.queue);
+        freeResources(res);
+        finishFrame(deviceIndex, load, -1.0);
+        throw"Failed to read dstBGRBuffer";
+    }
+    if (dstBGR.data != dstImage.data)
+        dstBGR.copyTo(dstImage);
+
+    //all commands on the images are done, give them to the next frame
+    recycleResources(res);
+    finishFrame(deviceIndex, load, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+Anime4KCPP::Anime4KGPU::KernelResources Anime4KCPP::Anime4KGPU::acquireResources(const size_t deviceIndex,
+    const int orgW, const int orgH, const int W, const int H, const bool lanczos)
+{
+    {
+        std::lock_guard<std::mutex> lock(resourcesMutex);
+        //sets of other sizes stay, frames may run at several sizes in turn, recycleResources drops old ones
+        for (auto it = resourcesCache.begin(); it != resourcesCache.end(); ++it)
+            if (it->deviceIndex == deviceIndex &&
+                it->orgW == orgW && it->orgH == orgH && it->W == W && it->H == H && it->lanczos == lanczos)
+            {
+                KernelResources res = *it;
+                resourcesCache.erase(it);
+                return res;
+            }
+    }
+
+    cl_int err;
+    const Device& dev = devices[deviceIndex];
+    KernelResources res{ deviceIndex, orgW, orgH, W, H, lanczos };
+
     cl_image_format format;
     cl_image_desc dstDesc;
     cl_image_desc orgDesc;
@@ -330,138 +655,253 @@ void Anime4KCPP::Anime4KGPU::runKernel(cv::InputArray orgImg, cv::OutputArray ds
     dstDesc.num_samples = 0;
     dstDesc.buffer = nullptr;
 
+    //every set has its own in-order queue, so frames of other threads don't wait behind this
+    //one and their uploads, kernels and readbacks can overlap on the device
+    res.queue = createCommandQueue(dev.context, dev.device);
+    if (res.queue == nullptr)
+    {
+        freeResources(res);
+        throw"Failed to create command queue";
+    }
+
     //kernel for each thread
-    cl_kernel kernelGetGray = nullptr;
-    if (zf == 2.0F)
-        kernelGetGray = clCreateKernel(program, "getGray", &err);
+    if (lanczos)
+        res.kernelGetGray = clCreateKernel(dev.program, "getGrayLanczos4", &err);
     else
-        kernelGetGray = clCreateKernel(program, "getGrayLanczos4", &err);
+        res.kernelGetGray = clCreateKernel(dev.program, "getGray", &err);
     if (err != CL_SUCCESS)
     {
+        freeResources(res);
         throw"Failed to create OpenCL kernel getGray";
     }
-    cl_kernel kernelPushColor = clCreateKernel(program, "pushColor", &err);
+    res.kernelPushColor = clCreateKernel(dev.program, "pushColor", &err);
     if (err != CL_SUCCESS)
     {
-        clReleaseKernel(kernelGetGray);
+        freeResources(res);
         throw"Failed to create OpenCL kernel pushColor";
     }
-    cl_kernel kernelGetGradient = clCreateKernel(program, "getGradient", &err);
+    res.kernelGetGradient = clCreateKernel(dev.program, "getGradient", &err);
     if (err != CL_SUCCESS)
     {
-        clReleaseKernel(kernelGetGray);
-        clReleaseKernel(kernelPushColor);
+        freeResources(res);
         throw"Failed to create OpenCL kernel getGradient";
     }
-    cl_kernel kernelPushGradient = clCreateKernel(program, "pushGradient", &err);
+    res.kernelPushGradient = clCreateKernel(dev.program, "pushGradient", &err);
     if (err != CL_SUCCESS)
     {
-        clReleaseKernel(kernelGetGray);
-        clReleaseKernel(kernelPushColor);
-        clReleaseKernel(kernelGetGradient);
+        freeResources(res);
         throw"Failed to create OpenCL kernel pushGradient";
     }
+    //the fused kernel needs work-groups of a whole tile, without them the separate kernels are used
+    res.kernelPushColorGradient = clCreateKernel(dev.program, "pushColorGradient", &err);
+    if (err == CL_SUCCESS)
+    {
+        size_t workGroupSize = 0;
+        err = clGetKernelWorkGroupInfo(res.kernelPushColorGradient, dev.device, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &workGroupSize, nullptr);
+        if (err != CL_SUCCESS || workGroupSize < 16 * 8)
+        {
+            clReleaseKernel(res.kernelPushColorGradient);
+            res.kernelPushColorGradient = nullptr;
+        }
+    }
+    else
+        res.kernelPushColorGradient = nullptr;
+    //24 bit frames and filters
+    const std::pair<cl_kernel*, const char*> kernels[] = {
+        { &res.kernelUnpackBGR, "unpackBGR" },
+        { &res.kernelPackBGR, "packBGR" },
+        { &res.kernelMedianBlur, "medianBlur" },
+        { &res.kernelMeanBlur, "meanBlur" },
+        { &res.kernelCASSharpening, "casSharpening" },
+        { &res.kernelGaussianBlur, "gaussianBlur" },
+        { &res.kernelBilateralFilter, "bilateralFilter" } };
+    for (const auto& kernel : kernels)
+    {
+        *kernel.first = clCreateKernel(dev.program, kernel.second, &err);
+        if (err != CL_SUCCESS)
+        {
+            *kernel.first = nullptr;
+            freeResources(res);
+            throw"Failed to create OpenCL filter kernel";
+        }
+    }
+
+    //BGR buffers for frames that are copied
+    res.orgBGRBuffer = clCreateBuffer(dev.context, CL_MEM_READ_ONLY, size_t(orgW) * orgH * 3, nullptr, &err);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        throw"orgBGRBuffer error";
+    }
+    res.dstBGRBuffer = clCreateBuffer(dev.context, CL_MEM_WRITE_ONLY, size_t(W) * H * 3, nullptr, &err);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        throw"dstBGRBuffer error";
+    }
 
     //imageBuffer
     //for getGray
-    cl_mem imageBuffer0 = clCreateImage(context, CL_MEM_READ_ONLY, &format, &orgDesc, nullptr, &err);
+    res.imageBuffer0 = clCreateImage(dev.context, CL_MEM_READ_WRITE, &format, &orgDesc, nullptr, &err);
     if (err != CL_SUCCESS)
     {
+        freeResources(res);
         throw"imageBuffer0 error";
     }
     //tmp buffer 1
-    cl_mem imageBuffer1 = clCreateImage(context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
+    res.imageBuffer1 = clCreateImage(dev.context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
     if (err != CL_SUCCESS)
     {
+        freeResources(res);
         throw"imageBuffer1 error";
     }
     //tmp buffer 2
-    cl_mem imageBuffer2 = clCreateImage(context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
+    res.imageBuffer2 = clCreateImage(dev.context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
     if (err != CL_SUCCESS)
     {
-        clReleaseMemObject(imageBuffer1);
+        freeResources(res);
         throw"imageBuffer2 error";
     }
     //tmp buffer 3
-    cl_mem imageBuffer3 = clCreateImage(context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
+    res.imageBuffer3 = clCreateImage(dev.context, CL_MEM_READ_WRITE, &format, &dstDesc, nullptr, &err);
     if (err != CL_SUCCESS)
     {
-        clReleaseMemObject(imageBuffer1);
+        freeResources(res);
         throw"imageBuffer3 error";
     }
 
-    //set arguments
-    //getGray
-    err = clSetKernelArg(kernelGetGray, 0, sizeof(cl_mem), &imageBuffer0);
-    err |= clSetKernelArg(kernelGetGray, 1, sizeof(cl_mem), &imageBuffer1);
-    err |= clSetKernelArg(kernelGetGray, 2, sizeof(cl_float), &normalizedWidth);
-    err |= clSetKernelArg(kernelGetGray, 3, sizeof(cl_float), &normalizedHeight);
-    if (err != CL_SUCCESS)
-        throw"getGray clSetKernelArg error";
-    //pushColor
-    err = clSetKernelArg(kernelPushColor, 0, sizeof(cl_mem), &imageBuffer1);
-    err |= clSetKernelArg(kernelPushColor, 1, sizeof(cl_mem), &imageBuffer2);
-    err |= clSetKernelArg(kernelPushColor, 2, sizeof(cl_float), &pushColorStrength);
-    if (err != CL_SUCCESS)
-        throw"pushColor clSetKernelArg error";
-    //getGradient
-    err = clSetKernelArg(kernelGetGradient, 0, sizeof(cl_mem), &imageBuffer2);
-    err |= clSetKernelArg(kernelGetGradient, 1, sizeof(cl_mem), &imageBuffer3);
-    if (err != CL_SUCCESS)
-        throw"getGradient clSetKernelArg error";
-    //pushGradient
-    err = clSetKernelArg(kernelPushGradient, 0, sizeof(cl_mem), &imageBuffer3);
-    err |= clSetKernelArg(kernelPushGradient, 1, sizeof(cl_mem), &imageBuffer1);
-    err |= clSetKernelArg(kernelPushGradient, 2, sizeof(cl_float), &pushGradientStrength);
-    if (err != CL_SUCCESS)
-        throw"pushGradient clSetKernelArg error";
+    return res;
+}
 
-    //enqueue
-    clEnqueueWriteImage(commandQueue, imageBuffer0, CL_FALSE, orgin, orgRegion, orgImage.step, 0, orgImage.data, 0, nullptr, nullptr);
-    clEnqueueNDRangeKernel(commandQueue, kernelGetGray, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
-    for (i = 0; i < ps && i < pcc; i++)//pcc for push color count
+void Anime4KCPP::Anime4KGPU::recycleResources(const KernelResources& res)
+{
+    std::lock_guard<std::mutex> lock(resourcesMutex);
+    resourcesCache.push_back(res);
+    //every thread of the pool may hold a set of each size a frame runs at, beyond that the sets of the device
+    //idle longest are of sizes nobody asks for anymore
+    const size_t maxSets = ThreadPool::instance().size() * maxCachedSizes;
+    size_t sets = std::count_if(resourcesCache.begin(), resourcesCache.end(),
+        [&](const KernelResources& cached) { return cached.deviceIndex == res.deviceIndex; });
+    for (auto it = resourcesCache.begin(); sets > maxSets;)
     {
-        clEnqueueNDRangeKernel(commandQueue, kernelPushColor, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
-        clEnqueueNDRangeKernel(commandQueue, kernelGetGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
-        clEnqueueNDRangeKernel(commandQueue, kernelPushGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+        if (it->deviceIndex != res.deviceIndex)
+        {
+            ++it;
+            continue;
+        }
+        freeResources(*it);
+        it = resourcesCache.erase(it);
+        sets--;
     }
-    if (i < ps)
+}
+
+void Anime4KCPP::Anime4KGPU::freeResources(const KernelResources& res)
+{
+    if (res.imageBuffer4 != nullptr)
+        clReleaseMemObject(res.imageBuffer4);
+    if (res.imageBuffer3 != nullptr)
+        clReleaseMemObject(res.imageBuffer3);
+    if (res.imageBuffer2 != nullptr)
+        clReleaseMemObject(res.imageBuffer2);
+    if (res.imageBuffer1 != nullptr)
+        clReleaseMemObject(res.imageBuffer1);
+    if (res.imageBuffer0 != nullptr)
+        clReleaseMemObject(res.imageBuffer0);
+    if (res.dstBGRBuffer != nullptr)
+        clReleaseMemObject(res.dstBGRBuffer);
+    if (res.orgBGRBuffer != nullptr)
+        clReleaseMemObject(res.orgBGRBuffer);
+
+    if (res.kernelGetGray != nullptr)
+        clReleaseKernel(res.kernelGetGray);
+    if (res.kernelPushColor != nullptr)
+        clReleaseKernel(res.kernelPushColor);
+    if (res.kernelGetGradient != nullptr)
+        clReleaseKernel(res.kernelGetGradient);
+    if (res.kernelPushGradient != nullptr)
+        clReleaseKernel(res.kernelPushGradient);
+    if (res.kernelPushColorGradient != nullptr)
+        clReleaseKernel(res.kernelPushColorGradient);
+    for (cl_kernel kernel : { res.kernelUnpackBGR, res.kernelPackBGR, res.kernelMedianBlur, res.kernelMeanBlur,
+        res.kernelCASSharpening, res.kernelGaussianBlur, res.kernelBilateralFilter })
+        if (kernel != nullptr)
+            clReleaseKernel(kernel);
+
+    if (res.queue != nullptr)
+        clReleaseCommandQueue(res.queue);
+}
+
+cl_mem Anime4KCPP::Anime4KGPU::wrapFrame(const Device& dev, const cl_mem_flags flags, const cv::Mat& frame)
+{
+    if (!frame.isContinuous() || reinterpret_cast<uintptr_t>(frame.data) % dev.hostPtrAlignment)
+        return nullptr;
+    cl_int err = CL_SUCCESS;
+    cl_mem ret = clCreateBuffer(dev.context, flags | CL_MEM_USE_HOST_PTR, frame.total() * frame.elemSize(), frame.data, &err);
+    return err == CL_SUCCESS ? ret : nullptr;
+}
+
+cl_int Anime4KCPP::Anime4KGPU::enqueueFilters(const KernelResources& res, const uint8_t filters, cl_mem& img, cl_mem& tmpImg, const size_t* size)
+{
+    cl_int err = CL_SUCCESS;
+    auto enqueue = [&](cl_kernel kernel)
     {
-        //reset getGradient
-        err = clSetKernelArg(kernelGetGradient, 0, sizeof(cl_mem), &imageBuffer1);
-        err |= clSetKernelArg(kernelGetGradient, 1, sizeof(cl_mem), &imageBuffer2);
-        if (err != CL_SUCCESS)
-            throw"Reset getGradient clSetKernelArg error";
-        //reset pushGradient
-        err = clSetKernelArg(kernelPushGradient, 0, sizeof(cl_mem), &imageBuffer2);
-        err |= clSetKernelArg(kernelPushGradient, 1, sizeof(cl_mem), &imageBuffer1);
-        err |= clSetKernelArg(kernelPushGradient, 2, sizeof(cl_float), &pushGradientStrength);
-        if (err != CL_SUCCESS)
-            throw"Reset pushGradient clSetKernelArg error";
+        err |= clSetKernelArg(kernel, 0, sizeof(cl_mem), &img);
+        err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &tmpImg);
+        err |= clEnqueueNDRangeKernel(res.queue, kernel, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+        std::swap(img, tmpImg);
+    };
+
+    if (filters & MEDIAN_BLUR)
+        enqueue(res.kernelMedianBlur);
+    if (filters & MEAN_BLUR)
+        enqueue(res.kernelMeanBlur);
+    if (filters & CAS_SHARPENING)
+        enqueue(res.kernelCASSharpening);
+    if (filters & (GAUSSIAN_BLUR_WEAK | GAUSSIAN_BLUR))
+    {
+        //normalized weights of cv::getGaussianKernel(3, sigma)
+        const double sigma = filters & GAUSSIAN_BLUR_WEAK ? 0.5 : 1.0;
+        const double side = std::exp(-1.0 / (2.0 * sigma * sigma));
+        const cl_float sideWeight = cl_float(side / (1.0 + 2.0 * side));
+        const cl_float centerWeight = cl_float(1.0 / (1.0 + 2.0 * side));
+        err |= clSetKernelArg(res.kernelGaussianBlur, 2, sizeof(cl_float), &sideWeight);
+        err |= clSetKernelArg(res.kernelGaussianBlur, 3, sizeof(cl_float), &centerWeight);
+        enqueue(res.kernelGaussianBlur);
+    }
+    if (filters & (BILATERAL_FILTER | BILATERAL_FILTER_FAST))
+    {
+        //cv::bilateralFilter(9, 30, 30) or (5, 35, 35)
+        const bool full = filters & BILATERAL_FILTER;
+        const cl_int radius = full ? 4 : 2;
+        const double sigma = full ? 30.0 : 35.0;
+        const cl_float coeff = cl_float(-0.5 / (sigma * sigma));
+        err |= clSetKernelArg(res.kernelBilateralFilter, 2, sizeof(cl_int), &radius);
+        err |= clSetKernelArg(res.kernelBilateralFilter, 3, sizeof(cl_float), &coeff);
+        err |= clSetKernelArg(res.kernelBilateralFilter, 4, sizeof(cl_float), &coeff);
+        enqueue(res.kernelBilateralFilter);
+    }
+    return err;
+}
 
-        while (i++ < ps)
+void Anime4KCPP::Anime4KGPU::initOpenCL(const std::vector<std::pair<unsigned int, unsigned int>>& deviceIDs)
+{
+    for (const auto& ids : deviceIDs)
+    {
+        try
+        {
+            devices.push_back(openDevice(ids.first, ids.second));
+        }
+        catch (...)
         {
-            clEnqueueNDRangeKernel(commandQueue, kernelGetGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
-            clEnqueueNDRangeKernel(commandQueue, kernelPushGradient, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+            releaseOpenCL();
+            throw;
         }
     }
-    //blocking read
-    clEnqueueReadImage(commandQueue, imageBuffer1, CL_TRUE, orgin, dstRegion, dstImage.step, 0, dstImage.data, 0, nullptr, nullptr);
-
-    //clean
-    clReleaseMemObject(imageBuffer3);
-    clReleaseMemObject(imageBuffer2);
-    clReleaseMemObject(imageBuffer1);
-    clReleaseMemObject(imageBuffer0);
-
-    clReleaseKernel(kernelGetGray);
-    clReleaseKernel(kernelPushColor);
-    clReleaseKernel(kernelGetGradient);
-    clReleaseKernel(kernelPushGradient);
 }
 
-void Anime4KCPP::Anime4KGPU::initOpenCL()
+Anime4KCPP::Anime4KGPU::Device Anime4KCPP::Anime4KGPU::openDevice(const unsigned int pID, const unsigned int dID)
 {
+    Device ret;
     cl_int err = 0;
     cl_uint platforms = 0;
     cl_uint devices = 0;
@@ -493,7 +933,8 @@ void Anime4KCPP::Anime4KGPU::initOpenCL()
     delete[] tmpPlatform;
 
     //init device
-    err = clGetDeviceIDs(currentplatform, CL_DEVICE_TYPE_GPU, 0, nullptr, &devices);
+    cl_device_id device = nullptr;
+    err = clGetDeviceIDs(currentplatform, deviceType, 0, nullptr, &devices);
     if (err != CL_SUCCESS || !devices)
     {
         std::cout << err << std::endl;
@@ -501,7 +942,7 @@ void Anime4KCPP::Anime4KGPU::initOpenCL()
     }
 
     cl_device_id* tmpDevice = new cl_device_id[devices];
-    err = clGetDeviceIDs(currentplatform, CL_DEVICE_TYPE_GPU, devices, tmpDevice, nullptr);
+    err = clGetDeviceIDs(currentplatform, deviceType, devices, tmpDevice, nullptr);
     if (err != CL_SUCCESS)
     {
         std::cout << err << std::endl;
@@ -515,94 +956,335 @@ void Anime4KCPP::Anime4KGPU::initOpenCL()
         device = tmpDevice[0];
 
     delete[] tmpDevice;
+    ret.device = device;
+
+    //CPUs and integrated GPUs share memory with the host
+    cl_bool hostUnifiedMemory = CL_FALSE;
+    err = clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(cl_bool), &hostUnifiedMemory, nullptr);
+    ret.hostUnifiedMemory = err == CL_SUCCESS && hostUnifiedMemory == CL_TRUE;
+    //frames are used in place if aligned to a page and to what the device asks of buffers, in bits
+    cl_uint baseAddrAlign = 0;
+    if (clGetDeviceInfo(device, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(cl_uint), &baseAddrAlign, nullptr) == CL_SUCCESS)
+        ret.hostPtrAlignment = std::max<size_t>(VideoIO::frameAlignment, baseAddrAlign / 8);
 
     //init context
-    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+    ret.context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
     if (err != CL_SUCCESS)
     {
         std::cout << err << std::endl;
-        releaseOpenCL();
+        closeDevice(ret);
         throw"Failed to create context";
     }
 
-    //init command queue
-    
-#ifndef CL_VERSION_2_0 //for OpenCL SDK older than v2.0 to build
-    commandQueue = clCreateCommandQueue(context, device, 0, &err);
-    if (err != CL_SUCCESS)
+#ifndef BUILT_IN_KERNEL
+    //read kernel files
+    std::string Anime4KCPPKernelSourceString = readKernel("Anime4KCPPKernel.cl");
+#endif // BUILT_IN_KERNEL
+
+    //create and build program, or load it from the program cache
+    ret.program = buildProgram(ret.context, ret.device, Anime4KCPPKernelSourceString);
+    if (ret.program == nullptr)
     {
-        std::cout << err << std::endl;
-        releaseOpenCL();
-        throw"Failed to create command queue";
+        closeDevice(ret);
+        throw"Kernel build error";
     }
-#else
-    commandQueue = clCreateCommandQueueWithProperties(context, device, nullptr, &err);
-    if (err != CL_SUCCESS)
+
+    return ret;
+}
+
+void Anime4KCPP::Anime4KGPU::closeDevice(const Device& dev)
+{
+    if (dev.program != nullptr)
+        clReleaseProgram(dev.program);
+    if (dev.context != nullptr)
+        clReleaseContext(dev.context);
+    if (dev.device != nullptr)
+        clReleaseDevice(dev.device);
+}
+
+void Anime4KCPP::Anime4KGPU::releaseOpenCL()
+{
+    for (const Device& dev : devices)
+        closeDevice(dev);
+    devices.clear();
+}
+
+size_t Anime4KCPP::Anime4KGPU::scheduleFrame(int& load)
+{
+    std::lock_guard<std::mutex> lock(devicesMutex);
+
+    //devices without a measured frame yet are taken as fast as the slowest one, so all
+    //of them get frames at first and a slow device doesn't hold back the start
+    double slowest = 0.0;
+    for (const Device& dev : devices)
+        slowest = std::max(slowest, dev.frameTime);
+    if (slowest == 0.0)
+        slowest = 1.0;
+
+    //the device that finishes one more frame first, its frames in flight included
+    size_t ret = 0;
+    double best = 0.0;
+    for (size_t i = 0; i < devices.size(); i++)
     {
-        if (err == CL_INVALID_DEVICE)//for GPUs that only support OpenCL1.2
+        const double frameTime = devices[i].frameTime > 0.0 ? devices[i].frameTime : slowest;
+        const double finish = (devices[i].inFlight + 1) * frameTime;
+        if (i == 0 || finish < best)
         {
+            best = finish;
+            ret = i;
+        }
+    }
+
+    load = ++devices[ret].inFlight;
+    return ret;
+}
+
+void Anime4KCPP::Anime4KGPU::finishFrame(const size_t deviceIndex, const int load, const double seconds)
+{
+    std::lock_guard<std::mutex> lock(devicesMutex);
+    Device& dev = devices[deviceIndex];
+    dev.inFlight--;
+    if (seconds < 0.0)
+        return;
+
+    //frames in flight on the same device share it, so a frame took about seconds / load of it
+    const double frameTime = seconds / load;
+    dev.frameTime = dev.frameTime > 0.0 ? dev.frameTime * 0.8 + frameTime * 0.2 : frameTime;
+}
+
+cl_command_queue Anime4KCPP::Anime4KGPU::createCommandQueue(cl_context context, cl_device_id device)
+{
+    cl_int err = 0;
+    cl_command_queue ret = nullptr;
+
+#ifndef CL_VERSION_2_0 //for OpenCL SDK older than v2.0 to build
+    ret = clCreateCommandQueue(context, device, 0, &err);
+#else
+    ret = clCreateCommandQueueWithProperties(context, device, nullptr, &err);
+    if (err == CL_INVALID_DEVICE)//for GPUs that only support OpenCL1.2
+    {
 #ifdef _MSC_VER
 #pragma warning (disable: 4996)// this is for building in MSVC
 #endif // _MSCV_VER
-            //do not worry about this warning, it is for compatibility
-            commandQueue = clCreateCommandQueue(context, device, 0, &err);
-            if (err != CL_SUCCESS)
-            {
-                std::cout << err << std::endl;
-                releaseOpenCL();
-                throw"Failed to create command queue";
-            }
-        }
-        else
-        {
-            std::cout << err << std::endl;
-            releaseOpenCL();
-            throw"Failed to create command queue";
-        }
+        //do not worry about this warning, it is for compatibility
+        ret = clCreateCommandQueue(context, device, 0, &err);
     }
 #endif // SPECIAL OPENCL VERSION
+    if (err != CL_SUCCESS)
+    {
+        std::cout << err << std::endl;
+        return nullptr;
+    }
+    return ret;
+}
 
-#ifndef BUILT_IN_KERNEL
-    //read kernel files
-    std::string Anime4KCPPKernelSourceString = readKernel("Anime4KCPPKernel.cl");
-#endif // BUILT_IN_KERNEL
-    const char* Anime4KCPPKernelSource = Anime4KCPPKernelSourceString.c_str();
+static std::string getDeviceInfo(cl_device_id device, cl_device_info param)
+{
+    size_t length = 0;
+    if (clGetDeviceInfo(device, param, 0, nullptr, &length) != CL_SUCCESS || !length)
+        return std::string();
+    std::string info(length, '\0');
+    if (clGetDeviceInfo(device, param, length, &info[0], nullptr) != CL_SUCCESS)
+        return std::string();
+    return info;
+}
+
+static std::string getPlatformInfo(cl_device_id device, cl_platform_info param)
+{
+    cl_platform_id platform = nullptr;
+    if (clGetDeviceInfo(device, CL_DEVICE_PLATFORM, sizeof(cl_platform_id), &platform, nullptr) != CL_SUCCESS)
+        return std::string();
+    size_t length = 0;
+    if (clGetPlatformInfo(platform, param, 0, nullptr, &length) != CL_SUCCESS || !length)
+        return std::string();
+    std::string info(length, '\0');
+    if (clGetPlatformInfo(platform, param, length, &info[0], nullptr) != CL_SUCCESS)
+        return std::string();
+    return info;
+}
+
+//Anime4KCPP in the cache directory of the user, empty if there is none
+static std::string getDefaultProgramCacheDir()
+{
+#ifdef _WIN32
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if (localAppData == nullptr || !*localAppData)
+        return std::string();
+    return (std::filesystem::path(localAppData) / "Anime4KCPP").string();
+#else
+    //relative paths in XDG_CACHE_HOME are invalid and ignored, as the XDG spec says
+    const char* xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+    if (xdgCacheHome != nullptr && *xdgCacheHome == '/')
+        return (std::filesystem::path(xdgCacheHome) / "Anime4KCPP").string();
+    const char* home = std::getenv("HOME");
+    if (home == nullptr || !*home)
+        return std::string();
+    return (std::filesystem::path(home) / ".cache" / "Anime4KCPP").string();
+#endif
+}
+
+//program binaries may be native code, so only a directory that nobody but the current user can write to is used.
+//It is created with mode 0700 if missing, on Windows the per-user directories are protected by their ACLs
+static bool checkProgramCacheDir(const std::string& dir)
+{
+    std::error_code ec;
+    const std::filesystem::path path(dir);
+#ifdef _WIN32
+    std::filesystem::create_directories(path, ec);
+    return std::filesystem::is_directory(path, ec);
+#else
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path(), ec);
+    if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+        return false;
+    struct stat info;
+    return lstat(dir.c_str(), &info) == 0 && S_ISDIR(info.st_mode) &&
+        info.st_uid == geteuid() && !(info.st_mode & (S_IWGRP | S_IWOTH));
+#endif
+}
+
+//a cached binary is only loaded if it is a regular file of the current user, the directory keeps others out
+static bool checkProgramCacheFile(const std::string& file)
+{
+#ifdef _WIN32
+    std::error_code ec;
+    return std::filesystem::is_regular_file(file, ec);
+#else
+    struct stat info;
+    return lstat(file.c_str(), &info) == 0 && S_ISREG(info.st_mode) && info.st_uid == geteuid();
+#endif
+}
+
+cl_program Anime4KCPP::Anime4KGPU::buildProgram(cl_context context, cl_device_id device, const std::string& source)
+{
+    cl_int err = 0;
+    cl_program ret = nullptr;
+
+    //a binary built before for the same device, driver and source skips the compiler
+    const std::string cacheFile = getProgramCacheFile(device, source);
+    if (!cacheFile.empty() && checkProgramCacheFile(cacheFile))
+    {
+        std::ifstream file(cacheFile, std::ios::binary);
+        if (file.is_open())
+        {
+            const std::vector<unsigned char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            const unsigned char* binaryData = binary.data();
+            const size_t binarySize = binary.size();
+            cl_int binaryStatus = CL_SUCCESS;
+            ret = clCreateProgramWithBinary(context, 1, &device, &binarySize, &binaryData, &binaryStatus, &err);
+            if (err == CL_SUCCESS && binaryStatus == CL_SUCCESS &&
+                clBuildProgram(ret, 1, &device, nullptr, nullptr, nullptr) == CL_SUCCESS)
+                return ret;
+            //broken or rejected binary, build from source and replace it
+            if (ret != nullptr)
+                clReleaseProgram(ret);
+        }
+    }
 
     //create program
-    program = clCreateProgramWithSource(context, 1, &Anime4KCPPKernelSource, nullptr, &err);
+    const char* sourceData = source.c_str();
+    ret = clCreateProgramWithSource(context, 1, &sourceData, nullptr, &err);
     if (err != CL_SUCCESS)
     {
         std::cout << err << std::endl;
-        releaseOpenCL();
-        throw"Failed to create OpenCL program";
+        return nullptr;
     }
 
     //build program
-    err = clBuildProgram(program, 1, &device, nullptr, nullptr, nullptr);
+    err = clBuildProgram(ret, 1, &device, nullptr, nullptr, nullptr);
     if (err != CL_SUCCESS)
     {
         size_t buildErrorSize = 0;
-        clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &buildErrorSize);
+        clGetProgramBuildInfo(ret, device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &buildErrorSize);
         char* buildError = new char[buildErrorSize];
-        clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, buildErrorSize, buildError, nullptr);
-        releaseOpenCL();
+        clGetProgramBuildInfo(ret, device, CL_PROGRAM_BUILD_LOG, buildErrorSize, buildError, nullptr);
+        clReleaseProgram(ret);
         //print build info
         std::cout << buildError << std::endl;
         delete[] buildError;
-        throw"Kernel build error";
+        return nullptr;
     }
+
+    if (!cacheFile.empty())
+        saveProgramBinary(ret, cacheFile);
+    return ret;
 }
 
-void Anime4KCPP::Anime4KGPU::releaseOpenCL()
+std::string Anime4KCPP::Anime4KGPU::getProgramCacheFile(cl_device_id device, const std::string& source)
 {
-    if (program != nullptr)
-        clReleaseProgram(program);
-    if (commandQueue != nullptr)
-        clReleaseCommandQueue(commandQueue);
-    if (context != nullptr)
-        clReleaseContext(context);
-    if (device != nullptr)
-        clReleaseDevice(device);
+    const std::string dir = programCacheDirSet ? programCacheDir : getDefaultProgramCacheDir();
+    if (dir.empty() || !checkProgramCacheDir(dir))
+        return std::string();
+
+    //64 bit FNV-1a, stable between builds and platforms unlike std::hash
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto update = [&hash](const std::string& data) {
+        for (const unsigned char c : data)
+            hash = (hash ^ c) * 0x100000001b3ULL;
+        hash = (hash ^ 0xff) * 0x100000001b3ULL;
+    };
+    update(getPlatformInfo(device, CL_PLATFORM_NAME));
+    update(getPlatformInfo(device, CL_PLATFORM_VERSION));
+    update(getDeviceInfo(device, CL_DEVICE_NAME));
+    update(getDeviceInfo(device, CL_DEVICE_VERSION));
+    update(getDeviceInfo(device, CL_DRIVER_VERSION));
+    update(source);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+void Anime4KCPP::Anime4KGPU::saveProgramBinary(cl_program program, const std::string& cacheFile)
+{
+    //the cache is only an optimization, failing to write it is not an error
+    size_t binarySize = 0;
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, nullptr) != CL_SUCCESS || !binarySize)
+        return;
+    std::vector<unsigned char> binary(binarySize);
+    unsigned char* binaryData = binary.data();
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryData, nullptr) != CL_SUCCESS)
+        return;
+
+    //the directory was created and checked by getProgramCacheFile
+    std::error_code ec;
+    const std::filesystem::path path(cacheFile);
+
+    //write to a temporary file and rename it, so processes starting at the same time never read a partial binary
+    const std::filesystem::path tmpPath = path.string() + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+            static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count())) + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary);
+        if (!file.is_open())
+            return;
+        file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+        std::filesystem::remove(tmpPath, ec);
+}
+
+void Anime4KCPP::Anime4KGPU::setZeroCopy(const bool enable)
+{
+    zeroCopy = enable;
+}
+
+void Anime4KCPP::Anime4KGPU::setFusedKernel(const bool enable)
+{
+    fusedKernel = enable;
+}
+
+void Anime4KCPP::Anime4KGPU::setProgramCacheDir(const std::string& dir)
+{
+    programCacheDir = dir;
+    programCacheDirSet = true;
 }
 
 std::string Anime4KCPP::Anime4KGPU::readKernel(const std::string& fileName)
@@ -617,14 +1299,18 @@ std::string Anime4KCPP::Anime4KGPU::readKernel(const std::string& fileName)
 
 //init OpenCL arguments
 bool Anime4KCPP::Anime4KGPU::isInitialized = false;
-cl_context Anime4KCPP::Anime4KGPU::context = nullptr;
-cl_command_queue Anime4KCPP::Anime4KGPU::commandQueue = nullptr;
-cl_program Anime4KCPP::Anime4KGPU::program = nullptr;
-cl_device_id Anime4KCPP::Anime4KGPU::device = nullptr;
-unsigned int Anime4KCPP::Anime4KGPU::pID = 0U;
-unsigned int Anime4KCPP::Anime4KGPU::dID = 0U;
+std::vector<Anime4KCPP::Anime4KGPU::Device> Anime4KCPP::Anime4KGPU::devices;
+std::mutex Anime4KCPP::Anime4KGPU::devicesMutex;
+cl_device_type Anime4KCPP::Anime4KGPU::deviceType = CL_DEVICE_TYPE_GPU;
+bool Anime4KCPP::Anime4KGPU::fusedKernel = true;
+bool Anime4KCPP::Anime4KGPU::zeroCopy = true;
+std::string Anime4KCPP::Anime4KGPU::programCacheDir;
+bool Anime4KCPP::Anime4KGPU::programCacheDirSet = false;
+std::mutex Anime4KCPP::Anime4KGPU::resourcesMutex;
+std::vector<Anime4KCPP::Anime4KGPU::KernelResources> Anime4KCPP::Anime4KGPU::resourcesCache;
 
 #ifdef BUILT_IN_KERNEL
+//in pieces, MSVC doesn't take a string literal longer than 16K
 const std::string Anime4KCPP::Anime4KGPU::Anime4KCPPKernelSourceString =
 R"(#define MAX3(a, b, c) fmax(fmax(a,b),c)
 #define MIN3(a, b, c) fmin(fmin(a,b),c)
@@ -905,5 +1591,368 @@ __kernel void pushGradient(__read_only image2d_t srcImg, __write_only image2d_t
 
     mc.w = 0.299f * mc.z + 0.587f * mc.y + 0.114f * mc.x;
     write_imagef(dstImg, coord, mc);
+}
+)"
+R"(//pushColor, getGradient and pushGradient of one pass in one kernel. Every work-group loads its tile with 3 pixels
+//around it into local memory and runs the three steps there. The steps keep 8 bit pixels in between and clamp
+//coordinates at the frame edges like the images of the separate kernels do, so both give the same result
+#define TILE_W 16
+#define TILE_H 8
+#define TILE_SIZE (TILE_W * TILE_H)
+
+inline static float4 loadPixel(__local const uchar4* buf, int stride, int x, int y)
+{
+    return convert_float4(buf[y * stride + x]) / 255.0f;
+}
+
+inline static uchar4 toPixel(float4 p)
+{
+    return convert_uchar4_sat_rte(p * 255.0f);
+}
+
+#define LOAD_NEIGHBOURS(buf, stride, x, y) \
+    float4 tl = loadPixel(buf, stride, x - 1, y - 1); \
+    float4 tc = loadPixel(buf, stride, x, y - 1); \
+    float4 tr = loadPixel(buf, stride, x + 1, y - 1); \
+    float4 ml = loadPixel(buf, stride, x - 1, y); \
+    float4 mc = loadPixel(buf, stride, x, y); \
+    float4 mr = loadPixel(buf, stride, x + 1, y); \
+    float4 bl = loadPixel(buf, stride, x - 1, y + 1); \
+    float4 bc = loadPixel(buf, stride, x, y + 1); \
+    float4 br = loadPixel(buf, stride, x + 1, y + 1)
+
+__kernel __attribute__((reqd_work_group_size(TILE_W, TILE_H, 1)))
+void pushColorGradient(__read_only image2d_t srcImg, __write_only image2d_t dstImg, float strengthColor, float strengthGradient, int enablePushColor)
+{
+    //the frame with 3 pixels of border first, then the gradient with 1
+    __local uchar4 bufA[(TILE_W + 6) * (TILE_H + 6)];
+    //pushColor with 2 pixels of border
+    __local uchar4 bufB[(TILE_W + 4) * (TILE_H + 4)];
+
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const int lid = get_local_id(1) * TILE_W + get_local_id(0);
+    const int x0 = get_group_id(0) * TILE_W, y0 = get_group_id(1) * TILE_H;
+
+    for (int i = lid; i < (TILE_W + 6) * (TILE_H + 6); i += TILE_SIZE)
+        bufA[i] = toPixel(read_imagef(srcImg, samplerN, (int2)(x0 - 3 + i % (TILE_W + 6), y0 - 3 + i / (TILE_W + 6))));
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    //a border pixel outside the frame takes the value of the nearest frame pixel, as a clamped image read would
+    for (int i = lid; i < (TILE_W + 4) * (TILE_H + 4); i += TILE_SIZE)
+    {
+        const int x = clamp(x0 - 2 + i % (TILE_W + 4), 0, width - 1) - (x0 - 3);
+        const int y = clamp(y0 - 2 + i / (TILE_W + 4), 0, height - 1) - (y0 - 3);
+        if (!enablePushColor)
+        {
+            bufB[i] = bufA[y * (TILE_W + 6) + x];
+            continue;
+        }
+
+        LOAD_NEIGHBOURS(bufA, TILE_W + 6, x, y);
+        float maxD,minL;
+
+        //top and bottom
+        maxD = MAX3(bl.w, bc.w, br.w);
+        minL = MIN3(tl.w, tc.w, tr.w);
+        if (minL > mc.w && mc.w > maxD)
+            getLightest(&mc, &tl, &tc, &tr, strengthColor);
+        else
+        {
+            maxD = MAX3(tl.w, tc.w, tr.w);
+            minL = MIN3(bl.w, bc.w, br.w);
+            if (minL > mc.w && mc.w > maxD)
+                getLightest(&mc, &bl, &bc, &br, strengthColor);
+        }
+
+        //sundiagonal
+        maxD = MAX3(ml.w, mc.w, bc.w);
+        minL = MIN3(tc.w, tr.w, mr.w);
+        if (minL > maxD)
+            getLightest(&mc, &tc, &tr, &mr, strengthColor);
+        else
+        {
+            maxD = MAX3(tc.w, mc.w, mr.w);
+            minL = MIN3(ml.w, bl.w, bc.w);
+            if (minL > maxD)
+                getLightest(&mc, &ml, &bl, &bc, strengthColor);
+        }
+
+        //left and right
+        maxD = MAX3(tl.w, ml.w, bl.w);
+        minL = MIN3(tr.w, mr.w, br.w);
+        if (minL > mc.w && mc.w > maxD)
+            getLightest(&mc, &tr, &mr, &br, strengthColor);
+        else
+        {
+            maxD = MAX3(tr.w, mr.w, br.w);
+            minL = MIN3(tl.w, ml.w, bl.w);
+            if (minL > mc.w && mc.w > maxD)
+                getLightest(&mc, &tl, &ml, &bl, strengthColor);
+        }
+
+        //diagonal
+        maxD = MAX3(tc.w, mc.w, ml.w);
+        minL = MIN3(mr.w, br.w, bc.w);
+        if (minL > maxD)
+            getLightest(&mc, &mr, &br, &bc, strengthColor);
+        else
+        {
+            maxD = MAX3(bc.w, mc.w, mr.w);
+            minL = MIN3(ml.w, tl.w, tc.w);
+            if (minL > maxD)
+                getLightest(&mc, &ml, &tl, &tc, strengthColor);
+        }
+
+        bufB[i] = toPixel(mc);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    //gradient with 1 pixel of border, bufA is free again
+    for (int i = lid; i < (TILE_W + 2) * (TILE_H + 2); i += TILE_SIZE)
+    {
+        const int x = clamp(x0 - 1 + i % (TILE_W + 2), 0, width - 1) - (x0 - 2);
+        const int y = clamp(y0 - 1 + i / (TILE_W + 2), 0, height - 1) - (y0 - 2);
+
+        LOAD_NEIGHBOURS(bufB, TILE_W + 4, x, y);
+
+        const float gradX = tr.w + mr.w + mr.w + br.w - tl.w - ml.w - ml.w - bl.w;
+        const float gradY = tl.w + tc.w + tc.w + tr.w - bl.w - bc.w - bc.w - br.w;
+
+        const float grad = clamp(native_sqrt(gradX * gradX + gradY * gradY), 0.0f, 1.0f);
+        mc.w = 1.0f - grad;
+
+        bufA[i] = toPixel(mc);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const int gx = x0 + get_local_id(0), gy = y0 + get_local_id(1);
+    if (gx >= width || gy >= height)
+        return;
+
+    const int2 coord = (int2)(gx, gy);
+    LOAD_NEIGHBOURS(bufA, TILE_W + 2, get_local_id(0) + 1, get_local_id(1) + 1);
+    float maxD,minL;
+
+    //top and bottom
+    maxD = MAX3(bl.w, bc.w, br.w);
+    minL = MIN3(tl.w, tc.w, tr.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tl, &tc, &tr, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tl.w, tc.w, tr.w);
+    minL = MIN3(bl.w, bc.w, br.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &bl, &bc, &br, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //sundiagonal
+    maxD = MAX3(ml.w, mc.w, bc.w);
+    minL = MIN3(tc.w, tr.w, mr.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &tc, &tr, &mr, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tc.w, mc.w, mr.w);
+    minL = MIN3(ml.w, bl.w, bc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &ml, &bl, &bc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //left and right
+    maxD = MAX3(tl.w, ml.w, bl.w);
+    minL = MIN3(tr.w, mr.w, br.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tr, &mr, &br, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    maxD = MAX3(tr.w, mr.w, br.w);
+    minL = MIN3(tl.w, ml.w, bl.w);
+    if (minL > mc.w && mc.w > maxD)
+    {
+        getAVerage(&mc, &tl, &ml, &bl, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    //diagonal
+    maxD = MAX3(tc.w, mc.w, ml.w);
+    minL = MIN3(mr.w, br.w, bc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &mr, &br, &bc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+    maxD = MAX3(bc.w, mc.w, mr.w);
+    minL = MIN3(ml.w, tl.w, tc.w);
+    if (minL > maxD)
+    {
+        getAVerage(&mc, &ml, &tl, &tc, strengthGradient);
+        write_imagef(dstImg, coord, mc);
+        return;
+    }
+
+    mc.w = 0.299f * mc.z + 0.587f * mc.y + 0.114f * mc.x;
+    write_imagef(dstImg, coord, mc);
+}
+)"
+R"(//frames go to the device and come back as packed 24 bit BGR, the images keep BGRA for the kernels above
+__kernel void unpackBGR(__global const uchar* src, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    __global const uchar* p = src + (y * get_image_width(dstImg) + x) * 3;
+    write_imagef(dstImg, (int2)(x, y), (float4)(p[0], p[1], p[2], 255.0f) / 255.0f);
+}
+
+__kernel void packBGR(__read_only image2d_t srcImg, __global uchar* dst)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const uchar4 p = convert_uchar4_sat_rte(read_imagef(srcImg, samplerN, (int2)(x, y)) * 255.0f);
+    __global uchar* q = dst + (y * get_image_width(srcImg) + x) * 3;
+    q[0] = p.x;
+    q[1] = p.y;
+    q[2] = p.z;
+}
+
+//pre and post filters of FilterProcessor, they work on 8 bit values like the CPU ones and leave alpha alone.
+//Borders follow OpenCV: replicated for medianBlur and reflected without the edge pixel for the others
+inline static float4 readByte(__read_only image2d_t img, int x, int y)
+{
+    return round(read_imagef(img, samplerN, (int2)(x, y)) * 255.0f);
+}
+
+inline static void writeByte(__write_only image2d_t img, int2 coord, float4 p)
+{
+    write_imagef(img, coord, round(clamp(p, 0.0f, 255.0f)) / 255.0f);
+}
+
+inline static int reflect101(int i, int size)
+{
+    return i < 0 ? -i : (i >= size ? 2 * size - 2 - i : i);
+}
+
+#define SORT2(a, b) { const float4 t = fmin(a, b); b = fmax(a, b); a = t; }
+
+__kernel void medianBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    float4 p0 = readByte(srcImg, x - 1, y - 1), p1 = readByte(srcImg, x, y - 1), p2 = readByte(srcImg, x + 1, y - 1);
+    float4 p3 = readByte(srcImg, x - 1, y), p4 = readByte(srcImg, x, y), p5 = readByte(srcImg, x + 1, y);
+    float4 p6 = readByte(srcImg, x - 1, y + 1), p7 = readByte(srcImg, x, y + 1), p8 = readByte(srcImg, x + 1, y + 1);
+    const float alpha = p4.w;
+
+    //median of 9 with 19 compare-exchanges, for all channels at once
+    SORT2(p1, p2); SORT2(p4, p5); SORT2(p7, p8);
+    SORT2(p0, p1); SORT2(p3, p4); SORT2(p6, p7);
+    SORT2(p1, p2); SORT2(p4, p5); SORT2(p7, p8);
+    SORT2(p0, p3); SORT2(p5, p8); SORT2(p4, p7);
+    SORT2(p3, p6); SORT2(p1, p4); SORT2(p2, p5);
+    SORT2(p4, p7); SORT2(p4, p2); SORT2(p6, p4);
+    SORT2(p4, p2);
+
+    p4.w = alpha;
+    writeByte(dstImg, (int2)(x, y), p4);
+}
+
+__kernel void meanBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+
+    float4 sum = (float4)(0.0f);
+    for (int j = -1; j <= 1; j++)
+        for (int i = -1; i <= 1; i++)
+            sum += readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+
+    float4 p = sum / 9.0f;
+    p.w = readByte(srcImg, x, y).w;
+    writeByte(dstImg, (int2)(x, y), p);
+}
+
+//CAS of FilterProcessor, the second pixel takes itself as left neighbour like the CPU one does
+__kernel void casSharpening(__read_only image2d_t srcImg, __write_only image2d_t dstImg)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+
+    const float4 tc = readByte(srcImg, x, y > 0 ? y - 1 : y);
+    const float4 ml = readByte(srcImg, x > 1 ? x - 1 : x, y);
+    const float4 mc = readByte(srcImg, x, y);
+    const float4 mr = readByte(srcImg, x < width - 1 ? x + 1 : x, y);
+    const float4 bc = readByte(srcImg, x, y < height - 1 ? y + 1 : y);
+
+    const float4 minC = fmin(fmin(fmin(tc, ml), fmin(mc, mr)), bc);
+    const float4 maxC = fmax(fmax(fmax(tc, ml), fmax(mc, mr)), bc);
+
+    const float peak = -0.2f;
+    const float4 w = peak * sqrt(fmin(minC, 255.0f - maxC) * (1.0f / fmax(maxC, 1.0f)));
+
+    float4 p = (w * (tc + ml + mr + bc) + mc) / (1.0f + 4.0f * w);
+    p.w = mc.w;
+    writeByte(dstImg, (int2)(x, y), floor(clamp(p, 0.0f, 255.0f) + 0.5f));
+}
+
+//3x3 Gaussian with the weights of cv::getGaussianKernel for the sigma, side for the neighbours
+__kernel void gaussianBlur(__read_only image2d_t srcImg, __write_only image2d_t dstImg, float side, float center)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const float k[3] = { side, center, side };
+
+    float4 sum = (float4)(0.0f);
+    for (int j = -1; j <= 1; j++)
+    {
+        float4 line = (float4)(0.0f);
+        for (int i = -1; i <= 1; i++)
+            line += k[i + 1] * readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+        sum += k[j + 1] * line;
+    }
+
+    sum.w = readByte(srcImg, x, y).w;
+    writeByte(dstImg, (int2)(x, y), sum);
+}
+
+//cv::bilateralFilter for 3 channels: a round window of radius, the color distance is the sum of the channel differences
+__kernel void bilateralFilter(__read_only image2d_t srcImg, __write_only image2d_t dstImg, int radius, float spaceCoeff, float colorCoeff)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+    const int width = get_image_width(srcImg), height = get_image_height(srcImg);
+    const float4 mc = readByte(srcImg, x, y);
+
+    float4 sum = (float4)(0.0f);
+    float weightSum = 0.0f;
+    for (int j = -radius; j <= radius; j++)
+        for (int i = -radius; i <= radius; i++)
+        {
+            const int r2 = i * i + j * j;
+            if (r2 > radius * radius)
+                continue;
+            const float4 p = readByte(srcImg, reflect101(x + i, width), reflect101(y + j, height));
+            const float4 d = fabs(p - mc);
+            const float diff = d.x + d.y + d.z;
+            const float weight = exp(r2 * spaceCoeff) * exp(diff * diff * colorCoeff);
+            sum += p * weight;
+            weightSum += weight;
+        }
+
+    float4 p = sum / weightSum;
+    p.w = mc.w;
+    writeByte(dstImg, (int2)(x, y), p);
 })";
 #endif // BUILT_IN_KERNEL
\ No newline at end of file
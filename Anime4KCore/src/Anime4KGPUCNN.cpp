@@ -0,0 +1,429 @@
+#define DLL
+
+#include "Anime4KGPUCNN.h"
+
+Anime4KCPP::Anime4KGPUCNN::Anime4KGPUCNN(const Parameters& parameters) :
+    Anime4K(parameters) {}
+
+void Anime4KCPP::Anime4KGPUCNN::process()
+{
+    double tmpZf = log2(zf);
+    int tmpZfUp = ceil(tmpZf);
+    if (!vm)
+    {
+        cv::Mat tmpImg = orgImg;
+        cv::cvtColor(tmpImg, tmpImg, cv::COLOR_BGR2YUV);
+        for (int i = 0; i < tmpZfUp; i++)
+        {
+            runKernel(tmpImg, dstImg);
+
+            std::vector<cv::Mat> yuv(3);
+            cv::split(tmpImg, yuv);
+            cv::resize(yuv[U], yuv[U], cv::Size(0, 0), 2.0, 2.0, cv::INTER_LANCZOS4);
+            cv::resize(yuv[V], yuv[V], cv::Size(0, 0), 2.0, 2.0, cv::INTER_LANCZOS4);
+            cv::merge(std::vector{ dstImg,yuv[U],yuv[V] }, dstImg);
+            tmpImg = dstImg;
+        }
+        cv::cvtColor(dstImg, dstImg, cv::COLOR_YUV2BGR);
+        if (tmpZfUp - tmpZf > 0.00001)
+        {
+            cv::resize(dstImg, dstImg, cv::Size(W, H), 0, 0, cv::INTER_LANCZOS4);
+        }
+    }
+    else
+    {
+        VideoIO::instance().init(
+            [this, tmpZfUp, tmpZf]()
+            {
+                VideoIO& videoIO = VideoIO::instance();
+                Frame frame = videoIO.read();
+                //every buffer comes from the frame pool and goes back to it, the output after it's written
+                cv::Mat tmpFrame = frame.first;
+                std::vector<cv::Mat> buffers{ tmpFrame };
+                cv::cvtColor(tmpFrame, tmpFrame, cv::COLOR_BGR2YUV);
+                for (int i = 0; i < tmpZfUp; i++)
+                {
+                    const int rows = tmpFrame.rows, cols = tmpFrame.cols;
+                    cv::Mat yFrame = videoIO.acquireFrame(rows * 2, cols * 2, CV_8UC1);
+                    cv::Mat uFrame = videoIO.acquireFrame(rows, cols, CV_8UC1);
+                    cv::Mat vFrame = videoIO.acquireFrame(rows, cols, CV_8UC1);
+                    cv::Mat uFrameUp = videoIO.acquireFrame(rows * 2, cols * 2, CV_8UC1);
+                    cv::Mat vFrameUp = videoIO.acquireFrame(rows * 2, cols * 2, CV_8UC1);
+                    cv::Mat dstFrame = videoIO.acquireFrame(rows * 2, cols * 2, CV_8UC3);
+                    runKernel(tmpFrame, yFrame);
+
+                    cv::extractChannel(tmpFrame, uFrame, U);
+                    cv::extractChannel(tmpFrame, vFrame, V);
+                    cv::resize(uFrame, uFrameUp, cv::Size(0, 0), 2.0, 2.0, cv::INTER_LANCZOS4);
+                    cv::resize(vFrame, vFrameUp, cv::Size(0, 0), 2.0, 2.0, cv::INTER_LANCZOS4);
+                    cv::merge(std::vector{ yFrame,uFrameUp,vFrameUp }, dstFrame);
+                    buffers.insert(buffers.end(), { yFrame, uFrame, vFrame, uFrameUp, vFrameUp, dstFrame });
+                    tmpFrame = dstFrame;
+                }
+                cv::Mat outFrame = videoIO.acquireFrame(tmpFrame.rows, tmpFrame.cols, CV_8UC3);
+                cv::cvtColor(tmpFrame, outFrame, cv::COLOR_YUV2BGR);
+                if (tmpZfUp - tmpZf > 0.00001)
+                {
+                    buffers.push_back(outFrame);
+                    outFrame = videoIO.acquireFrame(H, W, CV_8UC3);
+                    cv::resize(buffers.back(), outFrame, cv::Size(W, H), 0, 0, cv::INTER_LANCZOS4);
+                }
+                for (const cv::Mat& buffer : buffers)
+                    videoIO.recycleFrame(buffer);
+                frame.first = outFrame;
+                videoIO.write(frame);
+            }
+            , mt, pp
+                ).process();
+    }
+}
+
+void Anime4KCPP::Anime4KGPUCNN::initGPU(unsigned int platformID, unsigned int deviceID, const cl_device_type type)
+{
+    if (!isInitialized)
+    {
+        Anime4KGPU::initGPU(platformID, deviceID, type);
+        initOpenCL();
+        isInitialized = true;
+    }
+}
+
+void Anime4KCPP::Anime4KGPUCNN::releaseGPU()
+{
+    if (isInitialized)
+    {
+        {
+            std::lock_guard<std::mutex> lock(resourcesMutex);
+            for (const KernelResources& res : resourcesCache)
+                freeResources(res);
+            resourcesCache.clear();
+        }
+        releaseOpenCL();
+        isInitialized = false;
+    }
+}
+
+bool Anime4KCPP::Anime4KGPUCNN::isInitializedGPU()
+{
+    return isInitialized;
+}
+
+void Anime4KCPP::Anime4KGPUCNN::runKernel(const cv::Mat& orgImg, cv::Mat& dstImg)
+{
+    cl_int err = CL_SUCCESS;
+
+    const cl_int width = orgImg.cols, height = orgImg.rows;
+    const cl_int srcStep = static_cast<cl_int>(orgImg.step);
+
+    //frames are spread over the devices of Anime4KGPU
+    int load = 0;
+    const size_t deviceIndex = Anime4KGPU::scheduleFrame(load);
+    const auto start = std::chrono::steady_clock::now();
+
+    //kernels, weights and buffers are reused by later frames of the same size and model
+    KernelResources res;
+    try
+    {
+        res = acquireResources(deviceIndex, width, height, srcStep, Anime4KCPUCNN::getLayers<float>());
+    }
+    catch (...)
+    {
+        Anime4KGPU::finishFrame(deviceIndex, load, -1.0);
+        throw;
+    }
+    const Anime4KCPUCNN::Layers& layers = *res.layers;
+    const size_t last = layers.kernels.size() - 1;
+
+    err = clEnqueueWriteBuffer(res.queue, res.srcBuffer, CL_FALSE, 0, orgImg.step * orgImg.rows, orgImg.data, 0, nullptr, nullptr);
+
+    //first layer
+    cl_int channels = layers.biases[0].cols;
+    size_t size[3] = { size_t(width), size_t(height), size_t(channels) };
+    err |= clSetKernelArg(res.kernelConvYToN, 0, sizeof(cl_mem), &res.srcBuffer);
+    err |= clSetKernelArg(res.kernelConvYToN, 1, sizeof(cl_int), &srcStep);
+    err |= clSetKernelArg(res.kernelConvYToN, 2, sizeof(cl_mem), &res.featureBuffers[0]);
+    err |= clSetKernelArg(res.kernelConvYToN, 3, sizeof(cl_int), &width);
+    err |= clSetKernelArg(res.kernelConvYToN, 4, sizeof(cl_int), &height);
+    err |= clSetKernelArg(res.kernelConvYToN, 5, sizeof(cl_int), &channels);
+    err |= clSetKernelArg(res.kernelConvYToN, 6, sizeof(cl_mem), &res.kernelBuffers[0]);
+    err |= clSetKernelArg(res.kernelConvYToN, 7, sizeof(cl_mem), &res.biasBuffers[0]);
+    err |= clEnqueueNDRangeKernel(res.queue, res.kernelConvYToN, 3, nullptr, size, nullptr, 0, nullptr, nullptr);
+
+    //3x3 layers, arguments are taken when a kernel is enqueued so one kernel object serves all of them
+    int cur = 0;
+    for (size_t i = 1; i < last; i++, cur ^= 1)
+    {
+        const cl_int inChannels = channels;
+        channels = layers.biases[i].cols;
+        size[2] = size_t(channels);
+        err |= clSetKernelArg(res.kernelConvNToN, 0, sizeof(cl_mem), &res.featureBuffers[cur]);
+        err |= clSetKernelArg(res.kernelConvNToN, 1, sizeof(cl_mem), &res.featureBuffers[cur ^ 1]);
+        err |= clSetKernelArg(res.kernelConvNToN, 2, sizeof(cl_int), &width);
+        err |= clSetKernelArg(res.kernelConvNToN, 3, sizeof(cl_int), &height);
+        err |= clSetKernelArg(res.kernelConvNToN, 4, sizeof(cl_int), &inChannels);
+        err |= clSetKernelArg(res.kernelConvNToN, 5, sizeof(cl_int), &channels);
+        err |= clSetKernelArg(res.kernelConvNToN, 6, sizeof(cl_mem), &res.kernelBuffers[i]);
+        err |= clSetKernelArg(res.kernelConvNToN, 7, sizeof(cl_mem), &res.biasBuffers[i]);
+        err |= clEnqueueNDRangeKernel(res.queue, res.kernelConvNToN, 3, nullptr, size, nullptr, 0, nullptr, nullptr);
+    }
+
+    //transposed conv to the 2x frame
+    const size_t dstSize[2] = { size_t(width) * 2, size_t(height) * 2 };
+    err |= clSetKernelArg(res.kernelConvTransposeNTo1, 0, sizeof(cl_mem), &res.featureBuffers[cur]);
+    err |= clSetKernelArg(res.kernelConvTransposeNTo1, 1, sizeof(cl_mem), &res.dstBuffer);
+    err |= clSetKernelArg(res.kernelConvTransposeNTo1, 2, sizeof(cl_int), &width);
+    err |= clSetKernelArg(res.kernelConvTransposeNTo1, 3, sizeof(cl_int), &channels);
+    err |= clSetKernelArg(res.kernelConvTransposeNTo1, 4, sizeof(cl_mem), &res.kernelBuffers[last]);
+    err |= clEnqueueNDRangeKernel(res.queue, res.kernelConvTransposeNTo1, 2, nullptr, dstSize, nullptr, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+    {
+        clFinish(res.queue);
+        freeResources(res);
+        Anime4KGPU::finishFrame(deviceIndex, load, -1.0);
+        throw"Failed to run OpenCL CNN kernels";
+    }
+
+    //blocking read, orgImg is three channels, so create never keeps a buffer dstImg shares with it
+    dstImg.create(height * 2, width * 2, CV_8UC1);
+    err = clEnqueueReadBuffer(res.queue, res.dstBuffer, CL_TRUE, 0, dstImg.total(), dstImg.data, 0, nullptr, nullptr);
+    if (err != CL_SUCCESS)
+    {
+        freeResources(res);
+        Anime4KGPU::finishFrame(deviceIndex, load, -1.0);
+        throw"Failed to read OpenCL CNN result";
+    }
+    recycleResources(res);
+    Anime4KGPU::finishFrame(deviceIndex, load, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+Anime4KCPP::Anime4KGPUCNN::KernelResources Anime4KCPP::Anime4KGPUCNN::acquireResources(const size_t deviceIndex,
+    const int width, const int height, const int srcStep, const std::shared_ptr<const Anime4KCPUCNN::Layers>& layers)
+{
+    {
+        std::lock_guard<std::mutex> lock(resourcesMutex);
+        for (auto it = resourcesCache.begin(); it != resourcesCache.end();)
+        {
+            //the model changed, idle resources with the weights of the old one won't be used again
+            if (it->layers != layers)
+            {
+                freeResources(*it);
+                it = resourcesCache.erase(it);
+                continue;
+            }
+            //with zoom factor > 2 every frame runs at each size in turn, so sets of other sizes stay
+            if (it->deviceIndex == deviceIndex && it->width == width && it->height == height && it->srcStep == srcStep)
+            {
+                KernelResources res = *it;
+                resourcesCache.erase(it);
+                return res;
+            }
+            ++it;
+        }
+    }
+
+    cl_int err = CL_SUCCESS;
+    const Anime4KGPU::Device& dev = Anime4KGPU::devices[deviceIndex];
+    KernelResources res;
+    res.deviceIndex = deviceIndex;
+    res.width = width;
+    res.height = height;
+    res.srcStep = srcStep;
+    res.layers = layers;
+
+    auto createBuffer = [&](const cl_mem_flags flags, const size_t size, const void* data) {
+        cl_mem buffer = clCreateBuffer(dev.context, flags, size, const_cast<void*>(data), &err);
+        if (err != CL_SUCCESS)
+        {
+            freeResources(res);
+            throw"Failed to create OpenCL buffer";
+        }
+        return buffer;
+    };
+    auto createKernel = [&](const char* name) {
+        cl_kernel kernel = clCreateKernel(programs[deviceIndex], name, &err);
+        if (err != CL_SUCCESS)
+        {
+            freeResources(res);
+            throw"Failed to create OpenCL kernel";
+        }
+        return kernel;
+    };
+
+    //own queue for each set like Anime4KGPU, so frames of other threads overlap with this one
+    res.queue = Anime4KGPU::createCommandQueue(dev.context, dev.device);
+    if (res.queue == nullptr)
+    {
+        freeResources(res);
+        throw"Failed to create command queue";
+    }
+
+    res.kernelConvYToN = createKernel("convYToN");
+    res.kernelConvNToN = createKernel("convNToN");
+    res.kernelConvTransposeNTo1 = createKernel("convTransposeNTo1");
+
+    //weights
+    int maxChannels = 1;
+    for (size_t i = 0; i < layers->kernels.size(); i++)
+    {
+        const cv::Mat& kernel = layers->kernels[i], & biases = layers->biases[i];
+        res.kernelBuffers.push_back(createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, kernel.total() * sizeof(cl_float), kernel.data));
+        res.biasBuffers.push_back(createBuffer(CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, biases.total() * sizeof(cl_float), biases.data));
+        maxChannels = std::max(maxChannels, biases.cols);
+    }
+
+    //frame and ping-pong feature maps
+    const size_t featureSize = static_cast<size_t>(width) * height * maxChannels * sizeof(cl_float);
+    res.srcBuffer = createBuffer(CL_MEM_READ_ONLY, static_cast<size_t>(srcStep) * height, nullptr);
+    res.featureBuffers[0] = createBuffer(CL_MEM_READ_WRITE, featureSize, nullptr);
+    res.featureBuffers[1] = createBuffer(CL_MEM_READ_WRITE, featureSize, nullptr);
+    res.dstBuffer = createBuffer(CL_MEM_WRITE_ONLY, static_cast<size_t>(width) * height * 4, nullptr);
+
+    return res;
+}
+
+void Anime4KCPP::Anime4KGPUCNN::recycleResources(const KernelResources& res)
+{
+    std::lock_guard<std::mutex> lock(resourcesMutex);
+    resourcesCache.push_back(res);
+    //the same bound as Anime4KGPU::recycleResources, the sets of the device idle longest go first
+    const size_t maxSets = ThreadPool::instance().size() * Anime4KGPU::maxCachedSizes;
+    size_t sets = std::count_if(resourcesCache.begin(), resourcesCache.end(),
+        [&](const KernelResources& cached) { return cached.deviceIndex == res.deviceIndex; });
+    for (auto it = resourcesCache.begin(); sets > maxSets;)
+    {
+        if (it->deviceIndex != res.deviceIndex)
+        {
+            ++it;
+            continue;
+        }
+        freeResources(*it);
+        it = resourcesCache.erase(it);
+        sets--;
+    }
+}
+
+void Anime4KCPP::Anime4KGPUCNN::freeResources(const KernelResources& res)
+{
+    for (cl_mem buffer : { res.srcBuffer, res.featureBuffers[0], res.featureBuffers[1], res.dstBuffer })
+        if (buffer != nullptr)
+            clReleaseMemObject(buffer);
+    for (cl_mem buffer : res.kernelBuffers)
+        clReleaseMemObject(buffer);
+    for (cl_mem buffer : res.biasBuffers)
+        clReleaseMemObject(buffer);
+
+    for (cl_kernel kernel : { res.kernelConvYToN, res.kernelConvNToN, res.kernelConvTransposeNTo1 })
+        if (kernel != nullptr)
+            clReleaseKernel(kernel);
+
+    if (res.queue != nullptr)
+        clReleaseCommandQueue(res.queue);
+}
+
+void Anime4KCPP::Anime4KGPUCNN::initOpenCL()
+{
+#ifndef BUILT_IN_KERNEL
+    //read kernel files
+    std::string Anime4KCPPCNNKernelSourceString = Anime4KGPU::readKernel("Anime4KCPPCNNKernel.cl");
+#endif // BUILT_IN_KERNEL
+
+    //create and build programs for every device, or load them from the program cache
+    for (const Anime4KGPU::Device& dev : Anime4KGPU::devices)
+    {
+        cl_program program = Anime4KGPU::buildProgram(dev.context, dev.device, Anime4KCPPCNNKernelSourceString);
+        if (program == nullptr)
+        {
+            releaseOpenCL();
+            throw"CNN kernel build error";
+        }
+        programs.push_back(program);
+    }
+}
+
+void Anime4KCPP::Anime4KGPUCNN::releaseOpenCL()
+{
+    for (cl_program program : programs)
+        clReleaseProgram(program);
+    programs.clear();
+}
+
+//init OpenCL arguments
+bool Anime4KCPP::Anime4KGPUCNN::isInitialized = false;
+std::vector<cl_program> Anime4KCPP::Anime4KGPUCNN::programs;
+std::mutex Anime4KCPP::Anime4KGPUCNN::resourcesMutex;
+std::vector<Anime4KCPP::Anime4KGPUCNN::KernelResources> Anime4KCPP::Anime4KGPUCNN::resourcesCache;
+
+#ifdef BUILT_IN_KERNEL
+const std::string Anime4KCPP::Anime4KGPUCNN::Anime4KCPPCNNKernelSourceString =
+R"(#pragma OPENCL FP_CONTRACT OFF
+
+#define RELU(x) fmax(x, 0.0f)
+
+//feature maps are float buffers of [y][x][channel], kernels are packed as [tap][input channel][output channel]
+//and summed in the same order as the CPU CNN, so float results match Anime4KCPUCNN
+__kernel void convYToN(
+    __global const uchar* src, const int srcStep,
+    __global float* dst,
+    const int width, const int height, const int channels,
+    __global const float* kernels, __global const float* biases)
+{
+    const int x = get_global_id(0), y = get_global_id(1), o = get_global_id(2);
+
+    //the second pixel takes itself as left neighbour
+    const int xs[3] = { x > 1 ? x - 1 : x, x, x < width - 1 ? x + 1 : x };
+    const int ys[3] = { y > 0 ? y - 1 : y, y, y < height - 1 ? y + 1 : y };
+
+    float sum = 0.0f;
+    for (int t = 0; t < 9; t++)
+    {
+        const float pixel = src[ys[t / 3] * srcStep + xs[t % 3] * 3] / 255.0f;
+        sum = t ? sum + pixel * kernels[t * channels + o] : pixel * kernels[o];
+    }
+    dst[(y * width + x) * channels + o] = RELU(sum + biases[o]);
+}
+
+__kernel void convNToN(
+    __global const float* src,
+    __global float* dst,
+    const int width, const int height, const int inChannels, const int outChannels,
+    __global const float* kernels, __global const float* biases)
+{
+    const int x = get_global_id(0), y = get_global_id(1), o = get_global_id(2);
+
+    const int xs[3] = { x > 1 ? x - 1 : x, x, x < width - 1 ? x + 1 : x };
+    const int ys[3] = { y > 0 ? y - 1 : y, y, y < height - 1 ? y + 1 : y };
+
+    float sum = 0.0f;
+    for (int c = 0; c < inChannels; c++)
+    {
+        float tmp = 0.0f;
+        for (int t = 0; t < 9; t++)
+        {
+            const float pixel = src[(ys[t / 3] * width + xs[t % 3]) * inChannels + c];
+            const float k = kernels[(t * inChannels + c) * outChannels + o];
+            tmp = t ? tmp + pixel * k : pixel * k;
+        }
+        sum = c ? sum + tmp : tmp;
+    }
+    dst[(y * width + x) * outChannels + o] = RELU(sum + biases[o]);
+}
+
+__kernel void convTransposeNTo1(
+    __global const float* src,
+    __global uchar* dst,
+    const int width, const int channels,
+    __global const float* kernels)
+{
+    const int x = get_global_id(0), y = get_global_id(1);
+
+    //every input pixel becomes 2x2 output pixels, each one takes its own tap of the 2x2 kernels
+    __global const float* pixel = src + ((y / 2) * width + x / 2) * channels;
+    __global const float* k = kernels + ((y % 2) * 2 + x % 2) * channels;
+
+    float tmp = pixel[0] * k[0];
+    for (int c = 1; c < channels; c++)
+        tmp = tmp + pixel[c] * k[c];
+    tmp = tmp * 255.0f;
+    dst[y * width * 2 + x] = tmp >= 255.0f ? 255 : (tmp <= 0.0f ? 0 : (uchar)tmp);
+})";
+#endif // BUILT_IN_KERNEL
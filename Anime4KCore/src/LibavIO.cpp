@@ -0,0 +1,459 @@
+#ifdef ENABLE_LIBAV
+
+#include "VideoIO.h"
+
+extern "C"
+{
+#include<libavformat/avformat.h>
+#include<libavcodec/avcodec.h>
+#include<libavutil/opt.h>
+#include<libavutil/pixdesc.h>
+#include<libswscale/swscale.h>
+}
+
+Anime4KCPP::LibavReader::~LibavReader()
+{
+    release();
+}
+
+bool Anime4KCPP::LibavReader::open(const std::string& srcFile)
+{
+    release();
+    if (avformat_open_input(&formatCtx, srcFile.c_str(), nullptr, nullptr) < 0)
+        return false;
+    if (avformat_find_stream_info(formatCtx, nullptr) < 0 ||
+        (streamIndex = av_find_best_stream(formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0)) < 0)
+    {
+        release();
+        return false;
+    }
+
+    AVStream* stream = formatCtx->streams[streamIndex];
+    const AVCodec* codec = avcodec_find_decoder(stream->codecpar->codec_id);
+    if (!codec || !(codecCtx = avcodec_alloc_context3(codec)) ||
+        avcodec_parameters_to_context(codecCtx, stream->codecpar) < 0)
+    {
+        release();
+        return false;
+    }
+    //frame threads of the decoder, one for every core
+    codecCtx->thread_count = 0;
+    if (avcodec_open2(codecCtx, codec, nullptr) < 0 ||
+        !(frame = av_frame_alloc()) || !(packet = av_packet_alloc()))
+    {
+        release();
+        return false;
+    }
+
+    fps = av_q2d(av_guess_frame_rate(formatCtx, stream, nullptr));
+    //containers without a frame count get an estimate from the duration, as OpenCV does
+    if (stream->nb_frames > 0)
+        frameCount = static_cast<double>(stream->nb_frames);
+    else if (stream->duration != AV_NOPTS_VALUE)
+        frameCount = std::floor(stream->duration * av_q2d(stream->time_base) * fps + 0.5);
+    else if (formatCtx->duration != AV_NOPTS_VALUE)
+        frameCount = std::floor(formatCtx->duration / static_cast<double>(AV_TIME_BASE) * fps + 0.5);
+    return true;
+}
+
+bool Anime4KCPP::LibavReader::isOpened() const
+{
+    return codecCtx != nullptr;
+}
+
+bool Anime4KCPP::LibavReader::read(cv::Mat& image)
+{
+    if (!isOpened() || !receiveFrame())
+        return false;
+    swsCtx = sws_getCachedContext(swsCtx, frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+        frame->width, frame->height, AV_PIX_FMT_BGR24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!swsCtx)
+    {
+        av_frame_unref(frame);
+        return false;
+    }
+    image.create(frame->height, frame->width, CV_8UC3);
+    uint8_t* dst[] = { image.data };
+    const int dstStride[] = { static_cast<int>(image.step) };
+    sws_scale(swsCtx, frame->data, frame->linesize, 0, frame->height, dst, dstStride);
+    av_frame_unref(frame);
+    return true;
+}
+
+bool Anime4KCPP::LibavReader::receiveFrame()
+{
+    for (;;)
+    {
+        const int ret = avcodec_receive_frame(codecCtx, frame);
+        if (ret == 0)
+        {
+            const int64_t pts = frame->best_effort_timestamp;
+            if (pts != AV_NOPTS_VALUE && pts < skipUntil)
+            {
+                av_frame_unref(frame);
+                continue;
+            }
+            skipUntil = INT64_MIN;
+            //frames without a timestamp are counted on from the last one
+            if (pts != AV_NOPTS_VALUE)
+            {
+                AVStream* stream = formatCtx->streams[streamIndex];
+                const int64_t start = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+                position = (pts - start) * av_q2d(stream->time_base) * 1000.0;
+                nextFrame = std::floor(position * fps / 1000.0 + 0.5) + 1.0;
+            }
+            else
+                nextFrame++;
+            return true;
+        }
+        if (ret != AVERROR(EAGAIN) || draining)
+            return false;
+
+        //the decoder needs more packets, at the end of the file it gets a null one to give out the frames it holds
+        if (av_read_frame(formatCtx, packet) < 0)
+        {
+            draining = true;
+            avcodec_send_packet(codecCtx, nullptr);
+            continue;
+        }
+        //a broken packet only costs its own frames
+        if (packet->stream_index == streamIndex)
+            avcodec_send_packet(codecCtx, packet);
+        av_packet_unref(packet);
+    }
+}
+
+double Anime4KCPP::LibavReader::get(int propId) const
+{
+    if (!isOpened())
+        return 0.0;
+    switch (propId)
+    {
+    case cv::CAP_PROP_FRAME_WIDTH:
+        return codecCtx->width;
+    case cv::CAP_PROP_FRAME_HEIGHT:
+        return codecCtx->height;
+    case cv::CAP_PROP_FPS:
+        return fps;
+    case cv::CAP_PROP_FRAME_COUNT:
+        return frameCount;
+    case cv::CAP_PROP_POS_FRAMES:
+        return nextFrame;
+    case cv::CAP_PROP_POS_MSEC:
+        return position;
+    default:
+        return 0.0;
+    }
+}
+
+bool Anime4KCPP::LibavReader::set(int propId, double value)
+{
+    if (!isOpened() || propId != cv::CAP_PROP_POS_FRAMES || fps <= 0.0)
+        return false;
+    //frame index to timestamp, exact for constant frame rate like the seek of OpenCV
+    AVStream* stream = formatCtx->streams[streamIndex];
+    const int64_t start = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+    const int64_t target = start + av_rescale_q(static_cast<int64_t>(value), av_inv_q(av_d2q(fps, 1 << 20)), stream->time_base);
+    if (av_seek_frame(formatCtx, streamIndex, target, AVSEEK_FLAG_BACKWARD) < 0)
+        return false;
+    avcodec_flush_buffers(codecCtx);
+    draining = false;
+    //a frame a little early by rounding still counts as the one asked for
+    skipUntil = target - av_rescale_q(1, av_inv_q(av_d2q(fps * 2.0, 1 << 20)), stream->time_base);
+    nextFrame = value;
+    return true;
+}
+
+void Anime4KCPP::LibavReader::release()
+{
+    sws_freeContext(swsCtx);
+    swsCtx = nullptr;
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    avcodec_free_context(&codecCtx);
+    avformat_close_input(&formatCtx);
+    streamIndex = -1;
+    fps = frameCount = nextFrame = position = 0.0;
+    skipUntil = INT64_MIN;
+    draining = false;
+}
+
+Anime4KCPP::LibavWriter::~LibavWriter()
+{
+    release();
+}
+
+bool Anime4KCPP::LibavWriter::open(const std::string& dstFile, const std::string& encoder, double fps, const cv::Size& size,
+    const EncoderOptions& options, const std::string& audioSrcFile)
+{
+    release();
+    if (avformat_alloc_output_context2(&formatCtx, nullptr, nullptr, dstFile.c_str()) < 0 || !formatCtx)
+        return false;
+
+    const AVCodec* codec = nullptr;
+    if (!options.encoder.empty())
+        codec = avcodec_find_encoder_by_name(options.encoder.c_str());
+    else
+    {
+        if (!encoder.empty())
+            codec = avcodec_find_encoder_by_name(encoder.c_str());
+        if (!codec)
+            codec = avcodec_find_encoder(formatCtx->oformat->video_codec);
+    }
+    if (!codec || codec->type != AVMEDIA_TYPE_VIDEO ||
+        !(stream = avformat_new_stream(formatCtx, nullptr)) || !(codecCtx = avcodec_alloc_context3(codec)))
+    {
+        release();
+        return false;
+    }
+
+    //yuv420p plays everywhere, so it is taken whenever the encoder can, otherwise its first format
+    AVPixelFormat pixelFormat = AV_PIX_FMT_YUV420P;
+    if (!options.pixelFormat.empty())
+        pixelFormat = av_get_pix_fmt(options.pixelFormat.c_str());
+    else if (codec->pix_fmts)
+    {
+        const AVPixelFormat* format = codec->pix_fmts;
+        while (*format != AV_PIX_FMT_NONE && *format != AV_PIX_FMT_YUV420P)
+            format++;
+        pixelFormat = *format == AV_PIX_FMT_NONE ? codec->pix_fmts[0] : *format;
+    }
+    if (pixelFormat == AV_PIX_FMT_NONE)
+    {
+        release();
+        return false;
+    }
+
+    //encoders like mpeg4 take no time base over 16 bits
+    const AVRational frameRate = av_d2q(fps > 0.0 ? fps : 25.0, 65535);
+    codecCtx->width = size.width;
+    codecCtx->height = size.height;
+    codecCtx->pix_fmt = pixelFormat;
+    codecCtx->framerate = frameRate;
+    codecCtx->time_base = av_inv_q(frameRate);
+    codecCtx->thread_count = options.threads;
+    if (options.bitRate > 0)
+        codecCtx->bit_rate = options.bitRate;
+    if (formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
+        codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    stream->time_base = codecCtx->time_base;
+
+    //private options of the encoder, the ones it doesn't have are left in the dictionary and ignored
+    AVDictionary* codecOptions = nullptr;
+    if (options.crf >= 0)
+        av_dict_set_int(&codecOptions, "crf", options.crf, 0);
+    if (!options.preset.empty())
+        av_dict_set(&codecOptions, "preset", options.preset.c_str(), 0);
+    const int ret = avcodec_open2(codecCtx, codec, &codecOptions);
+    av_dict_free(&codecOptions);
+    if (ret < 0 || avcodec_parameters_from_context(stream->codecpar, codecCtx) < 0 ||
+        !(frame = av_frame_alloc()) || !(packet = av_packet_alloc()))
+    {
+        release();
+        return false;
+    }
+    frame->format = codecCtx->pix_fmt;
+    frame->width = codecCtx->width;
+    frame->height = codecCtx->height;
+    if (av_frame_get_buffer(frame, 0) < 0)
+    {
+        release();
+        return false;
+    }
+
+    //the caller counts on the audio, so a failure fails the file rather than leaving it silent or with empty streams
+    if (!audioSrcFile.empty() && !openAudio(audioSrcFile))
+    {
+        release();
+        return false;
+    }
+
+    if (!(formatCtx->oformat->flags & AVFMT_NOFILE) && avio_open(&formatCtx->pb, dstFile.c_str(), AVIO_FLAG_WRITE) < 0)
+    {
+        release();
+        return false;
+    }
+    if (avformat_write_header(formatCtx, nullptr) < 0)
+    {
+        release();
+        return false;
+    }
+    opened = true;
+    return true;
+}
+
+bool Anime4KCPP::LibavWriter::openAudio(const std::string& audioSrcFile)
+{
+    if (avformat_open_input(&audioCtx, audioSrcFile.c_str(), nullptr, nullptr) < 0 ||
+        avformat_find_stream_info(audioCtx, nullptr) < 0)
+        return false;
+
+    //the output video starts at 0, so the audio is moved by the start of the source video to stay in sync
+    const int videoIndex = av_find_best_stream(audioCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    const AVStream* video = videoIndex < 0 ? nullptr : audioCtx->streams[videoIndex];
+    const int64_t videoStart = video && video->start_time != AV_NOPTS_VALUE ? video->start_time : 0;
+
+    audioStreams.assign(audioCtx->nb_streams, -1);
+    audioOffsets.assign(audioCtx->nb_streams, 0);
+    bool found = false;
+    for (unsigned int i = 0; i < audioCtx->nb_streams; i++)
+    {
+        //a container that doesn't know whether it holds the codec gets the stream anyway,
+        //if it can't avformat_write_header fails the file instead of leaving it silent
+        AVStream* in = audioCtx->streams[i];
+        if (in->codecpar->codec_type != AVMEDIA_TYPE_AUDIO ||
+            avformat_query_codec(formatCtx->oformat, in->codecpar->codec_id, FF_COMPLIANCE_NORMAL) == 0)
+            continue;
+        AVStream* out = avformat_new_stream(formatCtx, nullptr);
+        if (!out || avcodec_parameters_copy(out->codecpar, in->codecpar) < 0)
+            return false;
+        //the tag of the source container may mean something else in this one
+        out->codecpar->codec_tag = 0;
+        out->time_base = in->time_base;
+        audioStreams[i] = out->index;
+        if (video)
+            audioOffsets[i] = av_rescale_q(videoStart, video->time_base, in->time_base);
+        found = true;
+    }
+    //a source without audio the container can hold gives the video alone
+    if (!found)
+    {
+        avformat_close_input(&audioCtx);
+        return true;
+    }
+    return (audioPacket = av_packet_alloc()) != nullptr;
+}
+
+bool Anime4KCPP::LibavWriter::isOpened() const
+{
+    return opened;
+}
+
+bool Anime4KCPP::LibavWriter::write(const cv::Mat& image)
+{
+    if (!opened || failed)
+        return false;
+    if (image.type() != CV_8UC3 || av_frame_make_writable(frame) < 0)
+    {
+        failed = true;
+        return false;
+    }
+    swsCtx = sws_getCachedContext(swsCtx, image.cols, image.rows, AV_PIX_FMT_BGR24,
+        codecCtx->width, codecCtx->height, codecCtx->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (!swsCtx)
+    {
+        failed = true;
+        return false;
+    }
+    const uint8_t* src[] = { image.data };
+    const int srcStride[] = { static_cast<int>(image.step) };
+    sws_scale(swsCtx, src, srcStride, 0, image.rows, frame->data, frame->linesize);
+    frame->pts = nextPts++;
+    if (!encodeFrame(frame))
+        failed = true;
+    return !failed;
+}
+
+bool Anime4KCPP::LibavWriter::encodeFrame(AVFrame* videoFrame)
+{
+    if (avcodec_send_frame(codecCtx, videoFrame) < 0)
+        return false;
+    for (;;)
+    {
+        const int ret = avcodec_receive_packet(codecCtx, packet);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            return true;
+        if (ret < 0)
+            return false;
+        av_packet_rescale_ts(packet, codecCtx->time_base, stream->time_base);
+        packet->stream_index = stream->index;
+        //the audio up to this packet goes first, so the muxer never buffers more than a packet of either
+        if (!copyAudio(av_rescale_q(packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts, stream->time_base, av_get_time_base_q())))
+        {
+            av_packet_unref(packet);
+            return false;
+        }
+        //takes the packet and leaves it blank
+        if (av_interleaved_write_frame(formatCtx, packet) < 0)
+            return false;
+    }
+}
+
+bool Anime4KCPP::LibavWriter::copyAudio(int64_t time)
+{
+    while (audioCtx)
+    {
+        if (!audioPending)
+        {
+            //the end of the source is the end of its audio, any other error would cut it short
+            const int ret = av_read_frame(audioCtx, audioPacket);
+            if (ret < 0)
+            {
+                avformat_close_input(&audioCtx);
+                return ret == AVERROR_EOF;
+            }
+            const int index = audioPacket->stream_index;
+            if (index < 0 || index >= static_cast<int>(audioStreams.size()) || audioStreams[index] < 0)
+            {
+                av_packet_unref(audioPacket);
+                continue;
+            }
+            const int64_t offset = audioOffsets[index];
+            if (audioPacket->pts != AV_NOPTS_VALUE)
+                audioPacket->pts -= offset;
+            if (audioPacket->dts != AV_NOPTS_VALUE)
+                audioPacket->dts -= offset;
+            audioPending = true;
+        }
+
+        const AVStream* in = audioCtx->streams[audioPacket->stream_index];
+        const int64_t ts = audioPacket->dts != AV_NOPTS_VALUE ? audioPacket->dts : audioPacket->pts;
+        if (time != INT64_MAX && ts != AV_NOPTS_VALUE && av_rescale_q(ts, in->time_base, av_get_time_base_q()) > time)
+            break;
+        AVStream* out = formatCtx->streams[audioStreams[audioPacket->stream_index]];
+        av_packet_rescale_ts(audioPacket, in->time_base, out->time_base);
+        audioPacket->stream_index = out->index;
+        audioPacket->pos = -1;
+        audioPending = false;
+        if (av_interleaved_write_frame(formatCtx, audioPacket) < 0)
+        {
+            av_packet_unref(audioPacket);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Anime4KCPP::LibavWriter::release()
+{
+    //after a failed write the trailer is still written, so the frames before it can be played
+    bool ret = !failed;
+    if (opened)
+    {
+        if (!failed)
+            ret = encodeFrame(nullptr) && copyAudio(INT64_MAX);
+        ret &= av_write_trailer(formatCtx) >= 0;
+    }
+    if (formatCtx && !(formatCtx->oformat->flags & AVFMT_NOFILE))
+        ret &= avio_closep(&formatCtx->pb) >= 0;
+    avformat_free_context(formatCtx);
+    formatCtx = nullptr;
+    stream = nullptr;
+    avcodec_free_context(&codecCtx);
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    sws_freeContext(swsCtx);
+    swsCtx = nullptr;
+    nextPts = 0;
+    opened = false;
+    failed = false;
+
+    avformat_close_input(&audioCtx);
+    av_packet_free(&audioPacket);
+    audioStreams.clear();
+    audioOffsets.clear();
+    audioPending = false;
+    return ret;
+}
+
+#endif // ENABLE_LIBAV
@@ -1,8 +1,10 @@
+#define DLL
+
 #include "VideoIO.h"
 
 Anime4KCPP::VideoIO::~VideoIO()
 {
-    writer.release();
+    releaseVideoWriter(writer);
     reader.release();
 }
 
@@ -12,65 +14,568 @@ Anime4KCPP::VideoIO& Anime4KCPP::VideoIO::instance()
     return videoIOInstance;
 }
 
-Anime4KCPP::VideoIO& Anime4KCPP::VideoIO::init(std::function<void()>&& p, size_t t)
+Anime4KCPP::VideoIO& Anime4KCPP::VideoIO::init(std::function<void()>&& p, size_t t, ParallelPolicy pp)
 {
     processor = std::move(p);
     threads = t;
+    policy = pp;
     return *this;
 }
 
 void Anime4KCPP::VideoIO::process()
 {
-    ThreadPool pool(threads + 1);
-    std::atomic<size_t> stop = reader.get(cv::CAP_PROP_FRAME_COUNT);
+    //decode -> rawFrames -> processors -> reorderRing -> encode, every stage has a bound and blocks
+    //the one before it when full, so memory stays at a few frames per thread however long the video is.
+    //The stages hand frames over through lock-free rings and wait with Backoff instead of locks.
+    //Processors run on the shared pool, which also runs the rows of each frame in parallel
+    ThreadPool& pool = ThreadPool::instance();
+    //the split is undone however process() ends, as the pool is shared with every later run. The guard
+    //goes before the group, so the processors the group waits for on an exception still find it
+    struct SplitGuard
+    {
+        VideoIO& videoIO;
+        ThreadPool& pool;
+        ~SplitGuard()
+        {
+            videoIO.processors = nullptr;
+            pool.setLoopThreads(pool.size());
+        }
+    } splitGuard{ *this, pool };
+    TaskGroup processorGroup(pool);
+    processors = &processorGroup;
+    inFlight = 0;
+    splitThroughput.clear();
+    rawFrames = std::make_unique<MPMCQueue<Frame>>(threads);
+    encodeFailed = false;
+    frameAllocations = 0;
+    frameReuses = 0;
+    //the stages and the temporaries of a processor stay well below 32 buffers per thread, idle ones beyond
+    //that are of sizes nobody asks for anymore and the oldest are dropped
+    poolSize = threads * 32;
+    segments.clear();
+    indexFile.clear();
+
+    if (segmentCount > 1 || checkpointFrames)
+    {
+        processSegments();
+        processorGroup.wait();
+        return;
+    }
+
+    reorderRing = std::make_unique<ReorderRing<Frame>>(threads * 2);
+    frameCount = 0;
+    decodeFinished = false;
+
+    //AUTO runs each split for a warm up and a measured window of frames
+    const ParallelPolicy candidates[] = { ParallelPolicy::FRAME, ParallelPolicy::MIXED, ParallelPolicy::ROW };
+    const size_t warmUpFrames = threads, measuredFrames = std::max<size_t>(threads * 4, 8);
+    size_t candidate = 0;
+    bool tuning = policy == ParallelPolicy::AUTO, measuring = !tuning;
+    ParallelPolicy current = tuning ? candidates[0] : policy;
+    applySplit(current);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t startIndex = 0, phaseEnd = warmUpFrames;
+    auto recordThroughput = [&](size_t endIndex)
+    {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (measuring && endIndex > startIndex)
+            splitThroughput.emplace_back(current, seconds > 0.0 ? (endIndex - startIndex) / seconds : 0.0);
+    };
+
+    std::thread decoder([this]()
+        {
+            decode(reader, 0, std::numeric_limits<size_t>::max(), frameCount, decodeFinished);
+        });
 
-    pool.exec([this, &stop]()
+    //encode in order on the caller thread
+    encode(*reorderRing, frameCount, decodeFinished, [&](Frame& frame)
         {
-            for (size_t i = 0; i < stop; i++)
+            if (!writeVideoFrame(writer, frame.first))
+                return false;
+            const size_t index = frame.second;
+            if (!tuning || index + 1 != phaseEnd)
+                return true;
+            if (measuring)
             {
-                std::unique_lock<std::mutex> lock(mtxWrite);
-                std::unordered_map<size_t, cv::Mat>::iterator it;
-                for (;;)
+                recordThroughput(phaseEnd);
+                if (++candidate < std::size(candidates))
+                {
+                    current = candidates[candidate];
+                    measuring = false;
+                    phaseEnd += warmUpFrames;
+                }
+                else//keep the fastest
                 {
-                    it = frameMap.find(i);
-                    if (it == frameMap.end())
-                        cndWrite.wait(lock);
-                    else
-                        break;
+                    current = std::max_element(splitThroughput.begin(), splitThroughput.end(),
+                        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+                    tuning = false;
                 }
-                writer.write(it->second);
-                frameMap.erase(it);
+                applySplit(current);
             }
+            else
+            {
+                measuring = true;
+                phaseEnd += measuredFrames;
+            }
+            start = std::chrono::steady_clock::now();
+            startIndex = index + 1;
+            return true;
         });
+    recordThroughput(reorderRing->next());
+
+    decoder.join();
+    processorGroup.wait();
+    if (encodeFailed)
+        throw "Failed to write video frame.";
+}
+
+void Anime4KCPP::VideoIO::processSegments()
+{
+    //segments are cut at frame indices from the frame count, not at keyframes, and every reader seeks to the
+    //first frame of its segment by CAP_PROP_POS_FRAMES. The frames at a cut are only neither lost nor repeated
+    //if that seek is exact, which it is for constant frame rate in indexed containers like mp4 and mkv, but
+    //not for variable frame rate or for containers the reader has to seek by estimate
+    const size_t totalFrames = static_cast<size_t>(std::max(reader.get(cv::CAP_PROP_FRAME_COUNT), 0.0));
+    //without a frame count there is nothing to cut by, one segment takes the whole video
+    size_t count = totalFrames ? segmentCount : 1;
+    //so every cut is tried before any frame is processed. If one isn't exact the whole video is written as one
+    //segment, a range of the segments can't be and fails, as the other machines would cut it all the same
+    if (count > 1)
+    {
+        const size_t length = std::max<size_t>((totalFrames + count - 1) / count, 1);
+        bool exact = true;
+        for (size_t i = 1; i < count && exact; i++)
+            exact = checkCut(reader, i * length);
+        reader.set(cv::CAP_PROP_POS_FRAMES, 0.0);
+        if (!exact)
+        {
+            if (firstSegment != 0 || lastSegment < count)
+                throw "Failed to cut the video into segments: the reader can't seek to exact frames.";
+            count = 1;
+        }
+    }
+    const size_t segmentLength = std::max<size_t>((totalFrames + count - 1) / count, 1);
+    const size_t last = std::min(lastSegment, count);
+    const size_t dot = dstPath.find_last_of('.'), slash = dstPath.find_last_of("/\\");
+    const std::string stem = dot != std::string::npos && (slash == std::string::npos || dot > slash) ? dstPath.substr(0, dot) : dstPath;
+    dstExtension = dstPath.substr(stem.size());
 
-    for (size_t i = 0; i < stop; i++)
+    //every range of segments has an index of its own, as other machines may be writing other ranges of the
+    //same video and nobody else ever opens this one. Without resume its chunks are stale, with resume it is
+    //rewritten without the line a kill may have cut
+    indexFile = dstPath + "." + std::to_string(firstSegment) + "-" + std::to_string(last) + ".index";
+    std::vector<Chunk> chunks;
+    if (resume)
+        chunks = loadIndex();
     {
-        cv::Mat frame;
-        if(!reader.read(frame))
-        {    
-            stop = i;
+        std::ofstream index(indexFile, std::ios::trunc);
+        for (const Chunk& chunk : chunks)
+            index << chunk.begin << ' ' << chunk.end << ' ' << chunk.file << std::endl;
+    }
+
+    segments.clear();
+    bool resumed = false;
+    for (size_t i = firstSegment; i < last; i++)
+    {
+        auto segment = std::make_unique<Segment>();
+        segment->begin = i * segmentLength;
+        //the frame count is an estimate, the last segment reads on until the video ends
+        segment->end = i == count - 1 ? std::numeric_limits<size_t>::max() : (i + 1) * segmentLength;
+        segment->name = stem + "_part" + std::to_string(i);
+        //follow the chunks from the start of the segment, a later record of the same frames wins
+        for (segment->start = segment->begin; segment->start < segment->end;)
+        {
+            auto chunk = std::find_if(chunks.rbegin(), chunks.rend(), [&](const Chunk& c)
+                {
+                    return c.begin == segment->start && c.end > c.begin && c.end <= segment->end && std::ifstream(c.file).good();
+                });
+            if (chunk == chunks.rend())
+                break;
+            segment->files.push_back(chunk->file);
+            segment->start = chunk->end;
+        }
+        //a resumed segment starts at a checkpoint inside it, which has to be as exact a cut as the segment ones
+        if (segment->start > segment->begin && segment->start < segment->end)
+        {
+            resumed = true;
+            if (!checkCut(reader, segment->start))
+                throw "Failed to resume: the reader can't seek to exact frames.";
+        }
+        if (segment->start < segment->end)
+        {
+            if (!openVideoReader(segment->reader, srcPath))
+                throw "Failed to load file: file doesn't not exist or decoder isn't installed.";
+            segment->reorderRing = std::make_unique<ReorderRing<Frame>>(threads * 2);
+        }
+        segments.push_back(std::move(segment));
+    }
+    if (resumed)
+        reader.set(cv::CAP_PROP_POS_FRAMES, 0.0);
+
+    //the cost of a frame is set by the decoders now, so AUTO has nothing to tune and runs frames in parallel
+    applySplit(policy == ParallelPolicy::AUTO ? ParallelPolicy::FRAME : policy);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    //every segment has a decoder and an encoder of its own, all share rawFrames and the processors
+    std::vector<std::thread> workers;
+    for (auto& segment : segments)
+    {
+        Segment& seg = *segment;
+        if (seg.start >= seg.end)
+            continue;
+        workers.emplace_back([this, &seg]()
+            {
+                if (!decode(seg.reader, seg.start, seg.end, seg.frameCount, seg.decodeFinished))
+                    seg.error = "Failed to seek to the first frame of a segment.";
+            });
+        workers.emplace_back([this, &seg]()
+            {
+                encode(*seg.reorderRing, seg.frameCount, seg.decodeFinished, [this, &seg](Frame& frame)
+                    {
+                        return encodeChunk(seg, frame);
+                    });
+                seg.reader.release();
+                if (seg.writer.isOpened())
+                {
+                    if (!releaseVideoWriter(seg.writer) && !seg.error)
+                        seg.error = "Failed to write video frame.";
+                    seg.chunkPending = true;
+                }
+                //the last chunk takes the rest of the segment, so resume knows nothing is left of it.
+                //After a processor threw or another segment failed the frames of the chunk stop short,
+                //so it is left to be done again
+                if (seg.chunkPending && !seg.error && !stopped())
+                {
+                    seg.chunk.end = seg.end;
+                    saveChunk(seg.chunk);
+                }
+            });
+    }
+    std::for_each(workers.begin(), workers.end(), std::mem_fn(&std::thread::join));
+
+    size_t written = 0;
+    for (auto& segment : segments)
+    {
+        if (segment->error)
+            throw segment->error;
+        written += segment->frameCount;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    splitThroughput.emplace_back(policy == ParallelPolicy::AUTO ? ParallelPolicy::FRAME : policy,
+        seconds > 0.0 ? written / seconds : 0.0);
+}
+
+bool Anime4KCPP::VideoIO::encodeChunk(Segment& seg, Frame& frame)
+{
+    //writers are opened by the first frame of a chunk, so a segment past the end of the video writes no file
+    if (!seg.writer.isOpened())
+    {
+        if (seg.chunkPending)
+        {
+            saveChunk(seg.chunk);
+            seg.chunkPending = false;
+        }
+        seg.chunk.begin = frame.second;
+        seg.chunk.file = seg.name + (checkpointFrames ? "_" + std::to_string(frame.second) : std::string()) + dstExtension;
+        //the audio is added once the files are concatenated
+        if (!openVideoWriter(seg.writer, seg.chunk.file, dstCodec, reader.get(cv::CAP_PROP_FPS), dstSize, encoderOptions, std::string()))
+        {
+            seg.error = "Failed to initialize video writer.";
+            return false;
+        }
+        seg.files.push_back(seg.chunk.file);
+    }
+    if (!writeVideoFrame(seg.writer, frame.first))
+    {
+        seg.error = "Failed to write video frame.";
+        return false;
+    }
+    //a chunk is only complete once its file is closed
+    if (checkpointFrames && frame.second + 1 - seg.chunk.begin == checkpointFrames)
+    {
+        if (!releaseVideoWriter(seg.writer))
+        {
+            seg.error = "Failed to write video frame.";
+            return false;
+        }
+        seg.chunk.end = frame.second + 1;
+        seg.chunkPending = true;
+    }
+    return true;
+}
+
+void Anime4KCPP::VideoIO::saveChunk(const Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lock(mtxIndex);
+    std::ofstream index(indexFile, std::ios::app);
+    index << chunk.begin << ' ' << chunk.end << ' ' << chunk.file << std::endl;
+}
+
+std::vector<Anime4KCPP::VideoIO::Chunk> Anime4KCPP::VideoIO::loadIndex() const
+{
+    //one chunk a line as begin end file, a line cut short by a kill is dropped
+    std::vector<Chunk> ret;
+    std::ifstream index(indexFile);
+    for (std::string line; std::getline(index, line);)
+    {
+        Chunk chunk;
+        std::istringstream fields(line);
+        if (fields >> chunk.begin >> chunk.end && fields.get() == ' ' && std::getline(fields, chunk.file) && !chunk.file.empty())
+            ret.push_back(std::move(chunk));
+    }
+    return ret;
+}
+
+bool Anime4KCPP::VideoIO::decode(Reader& capture, size_t begin, size_t end, size_t& count, std::atomic<bool>& finished)
+{
+    const int width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    const int height = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    if (begin && !seekVideoReader(capture, begin))
+    {
+        count = 0;
+        finished.store(true, std::memory_order_release);
+        return false;
+    }
+
+    size_t i = begin;
+    for (; i < end; i++)
+    {
+        //read reuses the buffer when the size matches
+        cv::Mat frame = acquireFrame(height, width, CV_8UC3);
+        if (!capture.read(frame))
+        {
+            recycleFrame(frame);
             break;
         }
+        //a processor that threw never hands its frame on, so nothing waits for the pipeline to drain after it
+        Frame rawFrame(frame, i);
+        bool failed = false;
+        for (Backoff backoff; !rawFrames->tryPush(std::move(rawFrame));)
+        {
+            if ((failed = stopped()))
+                break;
+            backoff.wait();
+        }
+        //frame level parallelism of the current split, the rest of the threads go to rows
+        for (Backoff backoff; !failed;)
+        {
+            size_t running = inFlight.load(std::memory_order_acquire);
+            if (running < frameThreads.load(std::memory_order_acquire) &&
+                inFlight.compare_exchange_weak(running, running + 1, std::memory_order_acq_rel))
+                break;
+            failed = stopped();
+            backoff.wait();
+        }
+        if (failed)
+            break;
+        processors->run([this]()
+            {
+                //the slot is given back however the processor ends, or the decoder waits for it forever
+                try
+                {
+                    processor();
+                }
+                catch (...)
+                {
+                    inFlight--;
+                    throw;
+                }
+                inFlight--;
+            });
+    }
+    count = i - begin;
+    finished.store(true, std::memory_order_release);
+    return true;
+}
+
+void Anime4KCPP::VideoIO::encode(ReorderRing<Frame>& ring, size_t& count, std::atomic<bool>& finished,
+    const std::function<bool(Frame&)>& encoder)
+{
+    for (Backoff backoff;;)
+    {
+        Frame frame;
+        if (!ring.tryTake(frame))
+        {
+            if (finished.load(std::memory_order_acquire) && ring.next() >= count)
+                break;
+            //the frame waited for is lost with the processor that threw, or another encoder failed,
+            //the caller throws the error
+            if (stopped())
+                break;
+            backoff.wait();
+            continue;
+        }
+        backoff = Backoff();
+        const bool written = encoder(frame);
+        recycleFrame(frame.first);
+        if (!written)
         {
-            std::unique_lock<std::mutex> lock(mtxRead);
-            while (rawFrames.size() >= threads)
-                cndRead.wait(lock);
-            rawFrames.emplace(std::pair<cv::Mat, size_t>(frame, i));
+            encodeFailed.store(true, std::memory_order_release);
+            break;
         }
-        pool.exec(processor);
     }
 }
 
+bool Anime4KCPP::VideoIO::stopped() const
+{
+    return processors->failed() || encodeFailed.load(std::memory_order_acquire);
+}
+
+const std::vector<std::pair<Anime4KCPP::ParallelPolicy, double>>& Anime4KCPP::VideoIO::getSplitThroughput() const
+{
+    return splitThroughput;
+}
+
+std::pair<size_t, size_t> Anime4KCPP::VideoIO::getSplit(ParallelPolicy pp, size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    switch (pp)
+    {
+    case ParallelPolicy::ROW:
+        return { 1, threads };
+    case ParallelPolicy::MIXED:
+    {
+        const size_t frames = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(threads))));
+        return { frames, std::max<size_t>(threads / frames, 1) };
+    }
+    case ParallelPolicy::FRAME:
+    default:
+        return { threads, 1 };
+    }
+}
+
+void Anime4KCPP::VideoIO::applySplit(ParallelPolicy pp)
+{
+    //frames already in flight keep running, the decoder starts new ones once fewer than the new count are
+    const std::pair<size_t, size_t> split = getSplit(pp, threads);
+    frameThreads.store(split.first, std::memory_order_release);
+    ThreadPool::instance().setLoopThreads(split.second);
+}
+
 bool Anime4KCPP::VideoIO::openReader(const std::string& srcFile)
 {
+    srcPath = srcFile;
+    return openVideoReader(reader, srcFile);
+}
+
+bool Anime4KCPP::VideoIO::openWriter(const std::string& dstFile, CODEC codec, const cv::Size& size, size_t segments, size_t checkpoint)
+{
+    dstPath = dstFile;
+    dstCodec = codec;
+    dstSize = size;
+    segmentCount = std::max<size_t>(segments, 1);
+    firstSegment = 0;
+    lastSegment = segmentCount;
+    checkpointFrames = checkpoint;
+    resume = false;
+    //segment writers are opened by process()
+    if (segmentCount > 1 || checkpointFrames)
+        return true;
+    return openVideoWriter(writer, dstFile, codec, reader.get(cv::CAP_PROP_FPS), size,
+        encoderOptions, encoderOptions.copyAudio ? srcPath : std::string());
+}
+
+void Anime4KCPP::VideoIO::setSegmentRange(size_t first, size_t last)
+{
+    firstSegment = std::min(first, segmentCount);
+    lastSegment = std::min(std::max(last, firstSegment), segmentCount);
+}
+
+void Anime4KCPP::VideoIO::setResume(bool flag)
+{
+    resume = flag;
+}
+
+std::vector<std::string> Anime4KCPP::VideoIO::getSegmentFiles() const
+{
+    std::vector<std::string> ret;
+    for (const auto& segment : segments)
+        ret.insert(ret.end(), segment->files.begin(), segment->files.end());
+    return ret;
+}
+
+std::string Anime4KCPP::VideoIO::getIndexFile() const
+{
+    return indexFile;
+}
+
+void Anime4KCPP::VideoIO::setEncoderOptions(const EncoderOptions& options)
+{
+    encoderOptions = options;
+}
+
+bool Anime4KCPP::VideoIO::canCopyAudio()
+{
+#ifdef ENABLE_LIBAV
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Anime4KCPP::VideoIO::openVideoReader(Reader& reader, const std::string& srcFile)
+{
+#ifdef ENABLE_LIBAV
+    return reader.open(srcFile);
+#else
     if (!reader.open(srcFile, cv::CAP_FFMPEG))
         return reader.open(srcFile);
     return reader.isOpened();
+#endif
 }
 
-bool Anime4KCPP::VideoIO::openWriter(const std::string& dstFile, CODEC codec, const cv::Size& size)
+bool Anime4KCPP::VideoIO::seekVideoReader(Reader& reader, const size_t frame)
 {
-    double fps = reader.get(cv::CAP_PROP_FPS);
+    return reader.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(frame)) &&
+        static_cast<size_t>(reader.get(cv::CAP_PROP_POS_FRAMES)) == frame;
+}
+
+bool Anime4KCPP::VideoIO::checkCut(Reader& reader, const size_t frame)
+{
+    const double fps = reader.get(cv::CAP_PROP_FPS);
+    if (fps <= 0.0 || !seekVideoReader(reader, frame))
+        return false;
+    //the frame count may be an estimate past the end, nothing is lost at a cut no frame follows
+    cv::Mat image;
+    if (!reader.read(image))
+        return true;
+    //the frame read has the timestamp of the index at constant frame rate, within half a frame
+    return std::abs(reader.get(cv::CAP_PROP_POS_MSEC) - frame * 1000.0 / fps) < 500.0 / fps;
+}
+
+//options and audio are only taken by the libav writer
+bool Anime4KCPP::VideoIO::openVideoWriter(Writer& writer, const std::string& dstFile, CODEC codec, double fps, const cv::Size& size,
+    [[maybe_unused]] const EncoderOptions& options, [[maybe_unused]] const std::string& audioSrcFile)
+{
+#ifdef ENABLE_LIBAV
+    //libav encoders of the codecs, a codec without its encoder built in falls back to the default of the container
+    std::string encoder;
+    switch (codec)
+    {
+    case CODEC::MP4V:
+        encoder = "mpeg4";
+        break;
+    case CODEC::DXVA:
+        encoder = "h264_mf";
+        break;
+    case CODEC::AVC1:
+        encoder = "libx264";
+        break;
+    case CODEC::VP09:
+        encoder = "libvpx-vp9";
+        break;
+    case CODEC::HEVC:
+        encoder = "libx265";
+        break;
+    case CODEC::AV01:
+        encoder = "libaom-av1";
+        break;
+    case CODEC::OTHER:
+    default:
+        break;
+    }
+    return writer.open(dstFile, encoder, fps, size, options, audioSrcFile);
+#else
     switch (codec)
     {
     case CODEC::MP4V:
@@ -140,6 +645,27 @@ bool Anime4KCPP::VideoIO::openWriter(const std::string& dstFile, CODEC codec, co
             return false;
     }
     return true;
+#endif
+}
+
+bool Anime4KCPP::VideoIO::writeVideoFrame(Writer& writer, const cv::Mat& frame)
+{
+#ifdef ENABLE_LIBAV
+    return writer.write(frame);
+#else
+    writer.write(frame);
+    return true;
+#endif
+}
+
+bool Anime4KCPP::VideoIO::releaseVideoWriter(Writer& writer)
+{
+#ifdef ENABLE_LIBAV
+    return writer.release();
+#else
+    writer.release();
+    return true;
+#endif
 }
 
 double Anime4KCPP::VideoIO::get(int p)
@@ -149,27 +675,94 @@ double Anime4KCPP::VideoIO::get(int p)
 
 void Anime4KCPP::VideoIO::release()
 {
-    writer.release();
+    const bool written = releaseVideoWriter(writer);
     reader.release();
+    {
+        std::lock_guard<std::mutex> lock(mtxPool);
+        framePool.clear();
+    }
+    if (!written)
+        throw "Failed to finish video file.";
 }
 
 Anime4KCPP::Frame Anime4KCPP::VideoIO::read()
 {
+    //the decoder pushes a frame before it gives a processor to the pool, so this rarely waits
     Frame ret;
+    for (Backoff backoff; !rawFrames->tryPop(ret);)
+        backoff.wait();
+    return ret;
+}
+
+void Anime4KCPP::VideoIO::write(const Frame& frame)
+{
+    //frames too far ahead of the encoder wait here, the frame it waits for is always in a processor
+    //that isn't waiting, as rawFrames hands out frames in order
+    ReorderRing<Frame>* ring = reorderRing.get();
+    size_t index = frame.second;
+    if (!segments.empty())
     {
-        std::lock_guard<std::mutex> lock(mtxRead);
-        ret = std::move(rawFrames.front());
-        rawFrames.pop();
+        //the segment of the frame is the last one starting at or before it
+        auto segment = std::upper_bound(segments.begin(), segments.end(), frame.second,
+            [](size_t i, const std::unique_ptr<Segment>& seg) { return i < seg->begin; }) - 1;
+        ring = (*segment)->reorderRing.get();
+        index -= (*segment)->start;
+    }
+    for (Backoff backoff; !ring->tryPut(index, Frame(frame));)
+    {
+        //the encoder stops once a processor has thrown or a write failed, so the frame would wait forever
+        if (stopped())
+            return;
+        backoff.wait();
     }
-    cndRead.notify_all();
-    return std::move(ret);
 }
 
-void Anime4KCPP::VideoIO::write(const Frame& frame)
+cv::Mat Anime4KCPP::VideoIO::acquireFrame(int rows, int cols, int type)
 {
     {
-        std::lock_guard<std::mutex> lock(mtxWrite);
-        frameMap[frame.second] = frame.first;
+        std::lock_guard<std::mutex> lock(mtxPool);
+        for (auto it = framePool.begin(); it != framePool.end(); ++it)
+        {
+            if (it->rows == rows && it->cols == cols && it->type() == type)
+            {
+                cv::Mat ret = std::move(*it);
+                framePool.erase(it);
+                frameReuses++;
+                return ret;
+            }
+        }
     }
-    cndWrite.notify_all();
+    frameAllocations++;
+    return allocateFrame(rows, cols, type);
+}
+
+cv::Mat Anime4KCPP::VideoIO::allocateFrame(int rows, int cols, int type)
+{
+    if (CV_MAT_DEPTH(type) != CV_8U || rows <= 0 || cols <= 0)
+        return cv::Mat(rows, cols, type);
+    //an aligned part of a larger buffer, the frame holds a reference to all of it
+    const size_t bytes = static_cast<size_t>(rows) * static_cast<size_t>(cols) * CV_MAT_CN(type);
+    cv::Mat buffer(1, static_cast<int>(bytes + frameAlignment), CV_8UC1);
+    const size_t offset = (frameAlignment - reinterpret_cast<uintptr_t>(buffer.data) % frameAlignment) % frameAlignment;
+    return buffer.colRange(static_cast<int>(offset), static_cast<int>(offset + bytes)).reshape(CV_MAT_CN(type), rows);
+}
+
+void Anime4KCPP::VideoIO::recycleFrame(const cv::Mat& frame)
+{
+    if (frame.empty() || !frame.isContinuous())
+        return;
+    std::lock_guard<std::mutex> lock(mtxPool);
+    if (framePool.size() >= poolSize)
+        framePool.erase(framePool.begin());
+    framePool.push_back(frame);
+}
+
+size_t Anime4KCPP::VideoIO::getFrameAllocations() const
+{
+    return frameAllocations;
+}
+
+size_t Anime4KCPP::VideoIO::getFrameReuses() const
+{
+    return frameReuses;
 }
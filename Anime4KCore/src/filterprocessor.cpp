@@ -1,41 +1,63 @@
+#define DLL
+
 #include "filterprocessor.h"
 
-Anime4KCPP::FilterProcessor::FilterProcessor(cv::InputArray srcImg, uint8_t _filters) :
-    filters(_filters)
+Anime4KCPP::FilterProcessor::FilterProcessor(cv::InputArray srcImg, uint8_t _filters, const cv::Mat& tmp) :
+    tmpImg(tmp), filters(_filters)
 {
-    if (!((filters & BILATERAL_FILTER) || (filters & BILATERAL_FILTER_FAST)))
-        img = srcImg.getMat();
-    else
-    {
-        srcImg.copyTo(img);
-        tmpImg = srcImg.getMat();
-    }
+    img = srcImg.getMat();
     H = img.rows;
     W = img.cols;
 }
 
 void Anime4KCPP::FilterProcessor::process()
 {
+    //img and tmpImg are used as a ping-pong pair, every filter reads one and writes the other,
+    //so the result only needs to be copied back once, and only if it ends up in tmpImg
+    cv::Mat dstImg = img;
     if (filters & MEDIAN_BLUR)
-        cv::medianBlur(img, img, 3);
+    {
+        cv::medianBlur(img, tmpImg, 3);
+        cv::swap(img, tmpImg);
+    }
     if (filters & MEAN_BLUR)
-        cv::blur(img, img, cv::Size(3, 3));
+    {
+        cv::blur(img, tmpImg, cv::Size(3, 3));
+        cv::swap(img, tmpImg);
+    }
     if (filters & CAS_SHARPENING)
-        CASSharpening(img);
+    {
+        CASSharpening(img, tmpImg);
+        cv::swap(img, tmpImg);
+    }
     if (filters & GAUSSIAN_BLUR_WEAK)
-        cv::GaussianBlur(img, img, cv::Size(3, 3), 0.5);
+    {
+        cv::GaussianBlur(img, tmpImg, cv::Size(3, 3), 0.5);
+        cv::swap(img, tmpImg);
+    }
     else if (filters & GAUSSIAN_BLUR)
-        cv::GaussianBlur(img, img, cv::Size(3, 3), 1);
+    {
+        cv::GaussianBlur(img, tmpImg, cv::Size(3, 3), 1);
+        cv::swap(img, tmpImg);
+    }
     if (filters & BILATERAL_FILTER)
+    {
         cv::bilateralFilter(img, tmpImg, 9, 30, 30);
+        cv::swap(img, tmpImg);
+    }
     else if (filters & BILATERAL_FILTER_FAST)
+    {
         cv::bilateralFilter(img, tmpImg, 5, 35, 35);
+        cv::swap(img, tmpImg);
+    }
+    if (img.data != dstImg.data)
+        img.copyTo(dstImg);
 }
 
-inline void Anime4KCPP::FilterProcessor::CASSharpening(cv::InputArray img)
+inline void Anime4KCPP::FilterProcessor::CASSharpening(const cv::Mat& src, cv::Mat& dst)
 {
     const int lineStep = W * 3;
-    changEachPixelBGR(img, [&](const int i, const int j, RGBA pixel, Line curLine) {
+    changEachPixelBGR(src, dst, [&](const int i, const int j, RGBA pixel, Line curLine) {
         const int jp = j < (W - 1) * 3 ? 3 : 0;
         const int jn = j > 3 ? -3 : 0;
 
@@ -44,7 +66,7 @@ inline void Anime4KCPP::FilterProcessor::CASSharpening(cv::InputArray img)
         const Line nLineData = i > 0 ? curLine - lineStep : curLine;
 
         const RGBA tc = nLineData + j;
-        const RGBA ml = cLineData + j + jn, mc = pixel, mr = cLineData + j + jp;
+        const RGBA ml = cLineData + j + jn, mc = cLineData + j, mr = cLineData + j + jp;
         const RGBA bc = pLineData + j;
 
         const uint8_t minR = MIN5(tc[R], ml[R], mc[R], mr[R], bc[R]);
@@ -67,32 +89,3 @@ inline void Anime4KCPP::FilterProcessor::CASSharpening(cv::InputArray img)
         pixel[B] = UNFLOAT(b);
         });
 }
-
-inline void Anime4KCPP::FilterProcessor::changEachPixelBGR(cv::InputArray _src, 
-    const std::function<void(const int, const int, RGBA, Line)>&& callBack)
-{
-    cv::Mat src = _src.getMat();
-    cv::Mat tmp;
-    src.copyTo(tmp);
-
-    int jMAX = W * 3;
-#ifdef _MSC_VER
-    Concurrency::parallel_for(0, H, [&](int i) {
-        Line lineData = src.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
-        Line tmpLineData = tmp.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
-        for (int j = 0; j < jMAX; j += 3)
-            callBack(i, j, tmpLineData + j, lineData);
-        });
-#else
-#pragma omp parallel for
-    for (int i = 0; i < H; i++)
-    {
-        Line lineData = src.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
-        Line tmpLineData = tmp.data + static_cast<size_t>(i) * static_cast<size_t>(W) * static_cast<size_t>(3);
-        for (int j = 0; j < jMAX; j += 3)
-            callBack(i, j, tmpLineData + j, lineData);
-    }
-#endif
-
-    tmp.copyTo(src);
-}
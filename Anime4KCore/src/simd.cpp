@@ -0,0 +1,845 @@
+#define DLL
+
+#include "simd.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86
+#include<immintrin.h>
+#ifdef _MSC_VER
+#include<intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SIMD_NEON
+#include<arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_SSE41
+#define TARGET_AVX2
+#else
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+//All kernels follow the scalar ones in Anime4KCPU exactly: the blend is done in float with
+//the same operation order and truncated, so the output is bit identical to the reference.
+
+static Anime4KCPP::SIMD::Level detectLevel()
+{
+#if defined(SIMD_X86)
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int maxID = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = info[2] & (1 << 19);
+    const bool osxsave = info[2] & (1 << 27);
+    bool avx2 = false;
+    if (maxID >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = info[1] & (1 << 5);
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return Anime4KCPP::SIMD::Level::AVX2;
+    if (sse41)
+        return Anime4KCPP::SIMD::Level::SSE41;
+    return Anime4KCPP::SIMD::Level::NONE;
+#elif defined(SIMD_NEON)
+    return Anime4KCPP::SIMD::Level::NEON;
+#else
+    return Anime4KCPP::SIMD::Level::NONE;
+#endif
+}
+
+static std::atomic<Anime4KCPP::SIMD::Level>& currentLevel()
+{
+    static std::atomic<Anime4KCPP::SIMD::Level> level(detectLevel());
+    return level;
+}
+
+Anime4KCPP::SIMD::Level Anime4KCPP::SIMD::getLevel()
+{
+    return currentLevel().load(std::memory_order_relaxed);
+}
+
+const char* Anime4KCPP::SIMD::getLevelName(const Level level)
+{
+    switch (level)
+    {
+    case Level::SSE41:
+        return "SSE4.1";
+    case Level::AVX2:
+        return "AVX2";
+    case Level::NEON:
+        return "NEON";
+    default:
+        return "None";
+    }
+}
+
+bool Anime4KCPP::SIMD::isSupported(const Level level)
+{
+    static const Level best = detectLevel();
+    switch (level)
+    {
+    case Level::NONE:
+        return true;
+    case Level::SSE41:
+        return best == Level::SSE41 || best == Level::AVX2;
+    default:
+        return level == best;
+    }
+}
+
+bool Anime4KCPP::SIMD::setLevel(const Level level)
+{
+    if (!isSupported(level))
+        return false;
+    currentLevel().store(level, std::memory_order_relaxed);
+    return true;
+}
+
+#ifdef SIMD_X86
+
+//SSE4.1, 4 pixels per vector
+
+TARGET_SSE41 static inline __m128i gtSSE41(const __m128i a, const __m128i b)
+{
+    const __m128i sign = _mm_set1_epi8(-128);
+    return _mm_cmpgt_epi8(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+
+TARGET_SSE41 static inline __m128i max3SSE41(const __m128i a, const __m128i b, const __m128i c)
+{
+    return _mm_max_epu8(_mm_max_epu8(a, b), c);
+}
+
+TARGET_SSE41 static inline __m128i min3SSE41(const __m128i a, const __m128i b, const __m128i c)
+{
+    return _mm_min_epu8(_mm_min_epu8(a, b), c);
+}
+
+//spread the comparison result of the alpha byte over the whole pixel
+TARGET_SSE41 static inline __m128i alphaMaskSSE41(const __m128i m)
+{
+    return _mm_shuffle_epi8(m, _mm_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15));
+}
+
+TARGET_SSE41 static inline __m128i blendSSE41(const __m128i mc, const __m128i sum, const __m128 s, const __m128 rs)
+{
+    const __m128 avg = _mm_div_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(3.0F));
+    return _mm_cvttps_epi32(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(mc), rs), _mm_mul_ps(avg, s)), _mm_set1_ps(0.5F)));
+}
+
+//mc * (1 - s) + (a + b + c) / 3 * s + 0.5 for each byte
+TARGET_SSE41 static inline __m128i lightestSSE41(const __m128i mc, const __m128i a, const __m128i b, const __m128i c, const __m128 s, const __m128 rs)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sumLo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)), _mm_unpacklo_epi8(c, zero));
+    const __m128i sumHi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)), _mm_unpackhi_epi8(c, zero));
+    const __m128i mcLo = _mm_unpacklo_epi8(mc, zero);
+    const __m128i mcHi = _mm_unpackhi_epi8(mc, zero);
+
+    const __m128i r0 = blendSSE41(_mm_unpacklo_epi16(mcLo, zero), _mm_unpacklo_epi16(sumLo, zero), s, rs);
+    const __m128i r1 = blendSSE41(_mm_unpackhi_epi16(mcLo, zero), _mm_unpackhi_epi16(sumLo, zero), s, rs);
+    const __m128i r2 = blendSSE41(_mm_unpacklo_epi16(mcHi, zero), _mm_unpacklo_epi16(sumHi, zero), s, rs);
+    const __m128i r3 = blendSSE41(_mm_unpackhi_epi16(mcHi, zero), _mm_unpackhi_epi16(sumHi, zero), s, rs);
+
+    return _mm_packus_epi16(_mm_packus_epi32(r0, r1), _mm_packus_epi32(r2, r3));
+}
+
+//two mutually exclusive candidates of one direction, both are compared with the same mc
+TARGET_SSE41 static inline __m128i pushColorStepSSE41(const __m128i mc,
+    const __m128i m1, const __m128i a1, const __m128i b1, const __m128i c1,
+    const __m128i m2, const __m128i a2, const __m128i b2, const __m128i c2,
+    const __m128 s, const __m128 rs)
+{
+    __m128i ret = mc;
+    if (!_mm_testz_si128(m1, m1))
+        ret = _mm_blendv_epi8(ret, lightestSSE41(mc, a1, b1, c1, s, rs), m1);
+    if (!_mm_testz_si128(m2, m2))
+        ret = _mm_blendv_epi8(ret, lightestSSE41(mc, a2, b2, c2, s, rs), m2);
+    return ret;
+}
+
+TARGET_SSE41 static int pushColorLineSSE41(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const __m128 s = _mm_set1_ps(strength), rs = _mm_set1_ps(1 - strength);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const int j = i * 4;
+        const __m128i tl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j - 4));
+        const __m128i tc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j));
+        const __m128i tr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j + 4));
+        const __m128i ml = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cLine + j - 4));
+        const __m128i mr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cLine + j + 4));
+        const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j - 4));
+        const __m128i bc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j));
+        const __m128i br = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j + 4));
+        __m128i mc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + j));
+        __m128i maxD, minL, m1, m2;
+
+        //top and bottom
+        maxD = max3SSE41(bl, bc, br);
+        minL = min3SSE41(tl, tc, tr);
+        m1 = alphaMaskSSE41(_mm_and_si128(gtSSE41(minL, mc), gtSSE41(mc, maxD)));
+        maxD = max3SSE41(tl, tc, tr);
+        minL = min3SSE41(bl, bc, br);
+        m2 = alphaMaskSSE41(_mm_and_si128(gtSSE41(minL, mc), gtSSE41(mc, maxD)));
+        mc = pushColorStepSSE41(mc, m1, tl, tc, tr, m2, bl, bc, br, s, rs);
+
+        //sundiagonal
+        maxD = max3SSE41(ml, mc, bc);
+        minL = min3SSE41(tc, tr, mr);
+        m1 = alphaMaskSSE41(gtSSE41(minL, maxD));
+        maxD = max3SSE41(tc, mc, mr);
+        minL = min3SSE41(ml, bl, bc);
+        m2 = alphaMaskSSE41(gtSSE41(minL, maxD));
+        mc = pushColorStepSSE41(mc, m1, tc, tr, mr, m2, ml, bl, bc, s, rs);
+
+        //left and right
+        maxD = max3SSE41(tl, ml, bl);
+        minL = min3SSE41(tr, mr, br);
+        m1 = alphaMaskSSE41(_mm_and_si128(gtSSE41(minL, mc), gtSSE41(mc, maxD)));
+        maxD = max3SSE41(tr, mr, br);
+        minL = min3SSE41(tl, ml, bl);
+        m2 = alphaMaskSSE41(_mm_and_si128(gtSSE41(minL, mc), gtSSE41(mc, maxD)));
+        mc = pushColorStepSSE41(mc, m1, tr, mr, br, m2, tl, ml, bl, s, rs);
+
+        //diagonal
+        maxD = max3SSE41(tc, mc, ml);
+        minL = min3SSE41(mr, br, bc);
+        m1 = alphaMaskSSE41(gtSSE41(minL, maxD));
+        maxD = max3SSE41(bc, mc, mr);
+        minL = min3SSE41(ml, tl, tc);
+        m2 = alphaMaskSSE41(gtSSE41(minL, maxD));
+        mc = pushColorStepSSE41(mc, m1, mr, br, bc, m2, ml, tl, tc, s, rs);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), mc);
+    }
+    return i;
+}
+
+//only the first matching candidate is taken, done marks the pixels that already have one
+TARGET_SSE41 static inline void pushGradientStepSSE41(__m128i& ret, __m128i& done, const __m128i mc, const __m128i cond,
+    const __m128i a, const __m128i b, const __m128i c, const __m128 s, const __m128 rs)
+{
+    const __m128i m = _mm_andnot_si128(done, alphaMaskSSE41(cond));
+    if (!_mm_testz_si128(m, m))
+    {
+        ret = _mm_blendv_epi8(ret, lightestSSE41(mc, a, b, c, s, rs), m);
+        done = _mm_or_si128(done, m);
+    }
+}
+
+TARGET_SSE41 static int pushGradientLineSSE41(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const __m128 s = _mm_set1_ps(strength), rs = _mm_set1_ps(1 - strength);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const int j = i * 4;
+        const __m128i tl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j - 4));
+        const __m128i tc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j));
+        const __m128i tr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nLine + j + 4));
+        const __m128i ml = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cLine + j - 4));
+        const __m128i mr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cLine + j + 4));
+        const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j - 4));
+        const __m128i bc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j));
+        const __m128i br = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + j + 4));
+        const __m128i mc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + j));
+        __m128i ret = mc, done = _mm_setzero_si128();
+
+        //top and bottom
+        pushGradientStepSSE41(ret, done, mc,
+            _mm_and_si128(gtSSE41(min3SSE41(tl, tc, tr), mc), gtSSE41(mc, max3SSE41(bl, bc, br))), tl, tc, tr, s, rs);
+        pushGradientStepSSE41(ret, done, mc,
+            _mm_and_si128(gtSSE41(min3SSE41(bl, bc, br), mc), gtSSE41(mc, max3SSE41(tl, tc, tr))), bl, bc, br, s, rs);
+        //sundiagonal
+        pushGradientStepSSE41(ret, done, mc, gtSSE41(min3SSE41(tc, tr, mr), max3SSE41(ml, mc, bc)), tc, tr, mr, s, rs);
+        pushGradientStepSSE41(ret, done, mc, gtSSE41(min3SSE41(ml, bl, bc), max3SSE41(tc, mc, mr)), ml, bl, bc, s, rs);
+        //left and right
+        pushGradientStepSSE41(ret, done, mc,
+            _mm_and_si128(gtSSE41(min3SSE41(tr, mr, br), mc), gtSSE41(mc, max3SSE41(tl, ml, bl))), tr, mr, br, s, rs);
+        pushGradientStepSSE41(ret, done, mc,
+            _mm_and_si128(gtSSE41(min3SSE41(tl, ml, bl), mc), gtSSE41(mc, max3SSE41(tr, mr, br))), tl, ml, bl, s, rs);
+        //diagonal
+        pushGradientStepSSE41(ret, done, mc, gtSSE41(min3SSE41(mr, br, bc), max3SSE41(tc, mc, ml)), mr, br, bc, s, rs);
+        pushGradientStepSSE41(ret, done, mc, gtSSE41(min3SSE41(ml, tl, tc), max3SSE41(bc, mc, mr)), ml, tl, tc, s, rs);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), _mm_or_si128(ret, alpha));
+    }
+    return i;
+}
+
+//AVX2, 8 pixels per vector, unpack and pack work inside 128 bits lanes so the order is kept
+
+TARGET_AVX2 static inline __m256i gtAVX2(const __m256i a, const __m256i b)
+{
+    const __m256i sign = _mm256_set1_epi8(-128);
+    return _mm256_cmpgt_epi8(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+}
+
+TARGET_AVX2 static inline __m256i max3AVX2(const __m256i a, const __m256i b, const __m256i c)
+{
+    return _mm256_max_epu8(_mm256_max_epu8(a, b), c);
+}
+
+TARGET_AVX2 static inline __m256i min3AVX2(const __m256i a, const __m256i b, const __m256i c)
+{
+    return _mm256_min_epu8(_mm256_min_epu8(a, b), c);
+}
+
+TARGET_AVX2 static inline __m256i alphaMaskAVX2(const __m256i m)
+{
+    return _mm256_shuffle_epi8(m, _mm256_setr_epi8(
+        3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15,
+        3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15));
+}
+
+TARGET_AVX2 static inline __m256i blendAVX2(const __m256i mc, const __m256i sum, const __m256 s, const __m256 rs)
+{
+    const __m256 avg = _mm256_div_ps(_mm256_cvtepi32_ps(sum), _mm256_set1_ps(3.0F));
+    return _mm256_cvttps_epi32(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(mc), rs), _mm256_mul_ps(avg, s)), _mm256_set1_ps(0.5F)));
+}
+
+TARGET_AVX2 static inline __m256i lightestAVX2(const __m256i mc, const __m256i a, const __m256i b, const __m256i c, const __m256 s, const __m256 rs)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i sumLo = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero)), _mm256_unpacklo_epi8(c, zero));
+    const __m256i sumHi = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero)), _mm256_unpackhi_epi8(c, zero));
+    const __m256i mcLo = _mm256_unpacklo_epi8(mc, zero);
+    const __m256i mcHi = _mm256_unpackhi_epi8(mc, zero);
+
+    const __m256i r0 = blendAVX2(_mm256_unpacklo_epi16(mcLo, zero), _mm256_unpacklo_epi16(sumLo, zero), s, rs);
+    const __m256i r1 = blendAVX2(_mm256_unpackhi_epi16(mcLo, zero), _mm256_unpackhi_epi16(sumLo, zero), s, rs);
+    const __m256i r2 = blendAVX2(_mm256_unpacklo_epi16(mcHi, zero), _mm256_unpacklo_epi16(sumHi, zero), s, rs);
+    const __m256i r3 = blendAVX2(_mm256_unpackhi_epi16(mcHi, zero), _mm256_unpackhi_epi16(sumHi, zero), s, rs);
+
+    return _mm256_packus_epi16(_mm256_packus_epi32(r0, r1), _mm256_packus_epi32(r2, r3));
+}
+
+TARGET_AVX2 static inline __m256i pushColorStepAVX2(const __m256i mc,
+    const __m256i m1, const __m256i a1, const __m256i b1, const __m256i c1,
+    const __m256i m2, const __m256i a2, const __m256i b2, const __m256i c2,
+    const __m256 s, const __m256 rs)
+{
+    __m256i ret = mc;
+    if (!_mm256_testz_si256(m1, m1))
+        ret = _mm256_blendv_epi8(ret, lightestAVX2(mc, a1, b1, c1, s, rs), m1);
+    if (!_mm256_testz_si256(m2, m2))
+        ret = _mm256_blendv_epi8(ret, lightestAVX2(mc, a2, b2, c2, s, rs), m2);
+    return ret;
+}
+
+TARGET_AVX2 static int pushColorLineAVX2(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const __m256 s = _mm256_set1_ps(strength), rs = _mm256_set1_ps(1 - strength);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int j = i * 4;
+        const __m256i tl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j - 4));
+        const __m256i tc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j));
+        const __m256i tr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j + 4));
+        const __m256i ml = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cLine + j - 4));
+        const __m256i mr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cLine + j + 4));
+        const __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j - 4));
+        const __m256i bc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j));
+        const __m256i br = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j + 4));
+        __m256i mc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + j));
+        __m256i maxD, minL, m1, m2;
+
+        //top and bottom
+        maxD = max3AVX2(bl, bc, br);
+        minL = min3AVX2(tl, tc, tr);
+        m1 = alphaMaskAVX2(_mm256_and_si256(gtAVX2(minL, mc), gtAVX2(mc, maxD)));
+        maxD = max3AVX2(tl, tc, tr);
+        minL = min3AVX2(bl, bc, br);
+        m2 = alphaMaskAVX2(_mm256_and_si256(gtAVX2(minL, mc), gtAVX2(mc, maxD)));
+        mc = pushColorStepAVX2(mc, m1, tl, tc, tr, m2, bl, bc, br, s, rs);
+
+        //sundiagonal
+        maxD = max3AVX2(ml, mc, bc);
+        minL = min3AVX2(tc, tr, mr);
+        m1 = alphaMaskAVX2(gtAVX2(minL, maxD));
+        maxD = max3AVX2(tc, mc, mr);
+        minL = min3AVX2(ml, bl, bc);
+        m2 = alphaMaskAVX2(gtAVX2(minL, maxD));
+        mc = pushColorStepAVX2(mc, m1, tc, tr, mr, m2, ml, bl, bc, s, rs);
+
+        //left and right
+        maxD = max3AVX2(tl, ml, bl);
+        minL = min3AVX2(tr, mr, br);
+        m1 = alphaMaskAVX2(_mm256_and_si256(gtAVX2(minL, mc), gtAVX2(mc, maxD)));
+        maxD = max3AVX2(tr, mr, br);
+        minL = min3AVX2(tl, ml, bl);
+        m2 = alphaMaskAVX2(_mm256_and_si256(gtAVX2(minL, mc), gtAVX2(mc, maxD)));
+        mc = pushColorStepAVX2(mc, m1, tr, mr, br, m2, tl, ml, bl, s, rs);
+
+        //diagonal
+        maxD = max3AVX2(tc, mc, ml);
+        minL = min3AVX2(mr, br, bc);
+        m1 = alphaMaskAVX2(gtAVX2(minL, maxD));
+        maxD = max3AVX2(bc, mc, mr);
+        minL = min3AVX2(ml, tl, tc);
+        m2 = alphaMaskAVX2(gtAVX2(minL, maxD));
+        mc = pushColorStepAVX2(mc, m1, mr, br, bc, m2, ml, tl, tc, s, rs);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j), mc);
+    }
+    return i + pushColorLineSSE41(dst + i * 4, nLine + i * 4, cLine + i * 4, pLine + i * 4, count - i, strength);
+}
+
+TARGET_AVX2 static inline void pushGradientStepAVX2(__m256i& ret, __m256i& done, const __m256i mc, const __m256i cond,
+    const __m256i a, const __m256i b, const __m256i c, const __m256 s, const __m256 rs)
+{
+    const __m256i m = _mm256_andnot_si256(done, alphaMaskAVX2(cond));
+    if (!_mm256_testz_si256(m, m))
+    {
+        ret = _mm256_blendv_epi8(ret, lightestAVX2(mc, a, b, c, s, rs), m);
+        done = _mm256_or_si256(done, m);
+    }
+}
+
+TARGET_AVX2 static int pushGradientLineAVX2(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const __m256 s = _mm256_set1_ps(strength), rs = _mm256_set1_ps(1 - strength);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int j = i * 4;
+        const __m256i tl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j - 4));
+        const __m256i tc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j));
+        const __m256i tr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nLine + j + 4));
+        const __m256i ml = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cLine + j - 4));
+        const __m256i mr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cLine + j + 4));
+        const __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j - 4));
+        const __m256i bc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j));
+        const __m256i br = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLine + j + 4));
+        const __m256i mc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + j));
+        __m256i ret = mc, done = _mm256_setzero_si256();
+
+        //top and bottom
+        pushGradientStepAVX2(ret, done, mc,
+            _mm256_and_si256(gtAVX2(min3AVX2(tl, tc, tr), mc), gtAVX2(mc, max3AVX2(bl, bc, br))), tl, tc, tr, s, rs);
+        pushGradientStepAVX2(ret, done, mc,
+            _mm256_and_si256(gtAVX2(min3AVX2(bl, bc, br), mc), gtAVX2(mc, max3AVX2(tl, tc, tr))), bl, bc, br, s, rs);
+        //sundiagonal
+        pushGradientStepAVX2(ret, done, mc, gtAVX2(min3AVX2(tc, tr, mr), max3AVX2(ml, mc, bc)), tc, tr, mr, s, rs);
+        pushGradientStepAVX2(ret, done, mc, gtAVX2(min3AVX2(ml, bl, bc), max3AVX2(tc, mc, mr)), ml, bl, bc, s, rs);
+        //left and right
+        pushGradientStepAVX2(ret, done, mc,
+            _mm256_and_si256(gtAVX2(min3AVX2(tr, mr, br), mc), gtAVX2(mc, max3AVX2(tl, ml, bl))), tr, mr, br, s, rs);
+        pushGradientStepAVX2(ret, done, mc,
+            _mm256_and_si256(gtAVX2(min3AVX2(tl, ml, bl), mc), gtAVX2(mc, max3AVX2(tr, mr, br))), tl, ml, bl, s, rs);
+        //diagonal
+        pushGradientStepAVX2(ret, done, mc, gtAVX2(min3AVX2(mr, br, bc), max3AVX2(tc, mc, ml)), mr, br, bc, s, rs);
+        pushGradientStepAVX2(ret, done, mc, gtAVX2(min3AVX2(ml, tl, tc), max3AVX2(bc, mc, mr)), ml, tl, tc, s, rs);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j), _mm256_or_si256(ret, alpha));
+    }
+    return i + pushGradientLineSSE41(dst + i * 4, nLine + i * 4, cLine + i * 4, pLine + i * 4, count - i, strength);
+}
+
+//conv8To8 for AVX2, all 8 output channels of a pixel are one vector (two for double) and several pixels
+//share every kernel load. mul and add are kept apart in the scalar order, so results match the scalar kernel
+
+TARGET_AVX2 static int conv8To8LineAVX2(float* dst, const float* nLine, const float* cLine, const float* pLine, int count, const float* kernels, const float* biases)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 bias = _mm256_loadu_ps(biases);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const int j = i * 8;
+        const float* taps[9] = {
+            nLine + j - 8, nLine + j, nLine + j + 8,
+            cLine + j - 8, cLine + j, cLine + j + 8,
+            pLine + j - 8, pLine + j, pLine + j + 8 };
+        __m256 sum0 = zero, sum1 = zero, sum2 = zero, sum3 = zero;
+        for (int c = 0; c < 8; c++)
+        {
+            __m256 k = _mm256_loadu_ps(kernels + c * 8);
+            const float* t = taps[0] + c;
+            __m256 tmp0 = _mm256_mul_ps(_mm256_broadcast_ss(t), k);
+            __m256 tmp1 = _mm256_mul_ps(_mm256_broadcast_ss(t + 8), k);
+            __m256 tmp2 = _mm256_mul_ps(_mm256_broadcast_ss(t + 16), k);
+            __m256 tmp3 = _mm256_mul_ps(_mm256_broadcast_ss(t + 24), k);
+            for (int n = 1; n < 9; n++)
+            {
+                k = _mm256_loadu_ps(kernels + (n * 8 + c) * 8);
+                t = taps[n] + c;
+                tmp0 = _mm256_add_ps(tmp0, _mm256_mul_ps(_mm256_broadcast_ss(t), k));
+                tmp1 = _mm256_add_ps(tmp1, _mm256_mul_ps(_mm256_broadcast_ss(t + 8), k));
+                tmp2 = _mm256_add_ps(tmp2, _mm256_mul_ps(_mm256_broadcast_ss(t + 16), k));
+                tmp3 = _mm256_add_ps(tmp3, _mm256_mul_ps(_mm256_broadcast_ss(t + 24), k));
+            }
+            if (c)
+            {
+                sum0 = _mm256_add_ps(sum0, tmp0);
+                sum1 = _mm256_add_ps(sum1, tmp1);
+                sum2 = _mm256_add_ps(sum2, tmp2);
+                sum3 = _mm256_add_ps(sum3, tmp3);
+            }
+            else
+            {
+                sum0 = tmp0;
+                sum1 = tmp1;
+                sum2 = tmp2;
+                sum3 = tmp3;
+            }
+        }
+        //max(0, x) keeps x when it is -0 or NaN, the same as RULE
+        _mm256_storeu_ps(dst + j, _mm256_max_ps(zero, _mm256_add_ps(sum0, bias)));
+        _mm256_storeu_ps(dst + j + 8, _mm256_max_ps(zero, _mm256_add_ps(sum1, bias)));
+        _mm256_storeu_ps(dst + j + 16, _mm256_max_ps(zero, _mm256_add_ps(sum2, bias)));
+        _mm256_storeu_ps(dst + j + 24, _mm256_max_ps(zero, _mm256_add_ps(sum3, bias)));
+    }
+    return i;
+}
+
+TARGET_AVX2 static int conv8To8LineAVX2(double* dst, const double* nLine, const double* cLine, const double* pLine, int count, const double* kernels, const double* biases)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d biasLo = _mm256_loadu_pd(biases), biasHi = _mm256_loadu_pd(biases + 4);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const int j = i * 8;
+        const double* taps[9] = {
+            nLine + j - 8, nLine + j, nLine + j + 8,
+            cLine + j - 8, cLine + j, cLine + j + 8,
+            pLine + j - 8, pLine + j, pLine + j + 8 };
+        __m256d sum0Lo = zero, sum0Hi = zero, sum1Lo = zero, sum1Hi = zero;
+        for (int c = 0; c < 8; c++)
+        {
+            __m256d kLo = _mm256_loadu_pd(kernels + c * 8), kHi = _mm256_loadu_pd(kernels + c * 8 + 4);
+            const double* t = taps[0] + c;
+            __m256d x0 = _mm256_broadcast_sd(t), x1 = _mm256_broadcast_sd(t + 8);
+            __m256d tmp0Lo = _mm256_mul_pd(x0, kLo), tmp0Hi = _mm256_mul_pd(x0, kHi);
+            __m256d tmp1Lo = _mm256_mul_pd(x1, kLo), tmp1Hi = _mm256_mul_pd(x1, kHi);
+            for (int n = 1; n < 9; n++)
+            {
+                const double* k = kernels + (n * 8 + c) * 8;
+                kLo = _mm256_loadu_pd(k);
+                kHi = _mm256_loadu_pd(k + 4);
+                t = taps[n] + c;
+                x0 = _mm256_broadcast_sd(t);
+                x1 = _mm256_broadcast_sd(t + 8);
+                tmp0Lo = _mm256_add_pd(tmp0Lo, _mm256_mul_pd(x0, kLo));
+                tmp0Hi = _mm256_add_pd(tmp0Hi, _mm256_mul_pd(x0, kHi));
+                tmp1Lo = _mm256_add_pd(tmp1Lo, _mm256_mul_pd(x1, kLo));
+                tmp1Hi = _mm256_add_pd(tmp1Hi, _mm256_mul_pd(x1, kHi));
+            }
+            if (c)
+            {
+                sum0Lo = _mm256_add_pd(sum0Lo, tmp0Lo);
+                sum0Hi = _mm256_add_pd(sum0Hi, tmp0Hi);
+                sum1Lo = _mm256_add_pd(sum1Lo, tmp1Lo);
+                sum1Hi = _mm256_add_pd(sum1Hi, tmp1Hi);
+            }
+            else
+            {
+                sum0Lo = tmp0Lo;
+                sum0Hi = tmp0Hi;
+                sum1Lo = tmp1Lo;
+                sum1Hi = tmp1Hi;
+            }
+        }
+        _mm256_storeu_pd(dst + j, _mm256_max_pd(zero, _mm256_add_pd(sum0Lo, biasLo)));
+        _mm256_storeu_pd(dst + j + 4, _mm256_max_pd(zero, _mm256_add_pd(sum0Hi, biasHi)));
+        _mm256_storeu_pd(dst + j + 8, _mm256_max_pd(zero, _mm256_add_pd(sum1Lo, biasLo)));
+        _mm256_storeu_pd(dst + j + 12, _mm256_max_pd(zero, _mm256_add_pd(sum1Hi, biasHi)));
+    }
+    return i;
+}
+
+#endif // SIMD_X86
+
+#ifdef SIMD_NEON
+
+//NEON, 4 pixels per vector
+
+static inline uint8x16_t alphaMaskNEON(const uint8x16_t m)
+{
+    static const uint8_t index[16] = { 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15 };
+    return vqtbl1q_u8(m, vld1q_u8(index));
+}
+
+static inline uint8x16_t max3NEON(const uint8x16_t a, const uint8x16_t b, const uint8x16_t c)
+{
+    return vmaxq_u8(vmaxq_u8(a, b), c);
+}
+
+static inline uint8x16_t min3NEON(const uint8x16_t a, const uint8x16_t b, const uint8x16_t c)
+{
+    return vminq_u8(vminq_u8(a, b), c);
+}
+
+static inline bool anyNEON(const uint8x16_t m)
+{
+    return vmaxvq_u8(m) != 0;
+}
+
+//multiplies and adds stay separate as in getLightest, the build keeps the compiler from fusing either
+static inline uint32x4_t blendNEON(const uint16x4_t mc, const uint16x4_t sum, const float32x4_t s, const float32x4_t rs)
+{
+    const float32x4_t avg = vdivq_f32(vcvtq_f32_u32(vmovl_u16(sum)), vdupq_n_f32(3.0F));
+    return vcvtq_u32_f32(
+        vaddq_f32(vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(mc)), rs), vmulq_f32(avg, s)), vdupq_n_f32(0.5F)));
+}
+
+static inline uint8x16_t lightestNEON(const uint8x16_t mc, const uint8x16_t a, const uint8x16_t b, const uint8x16_t c, const float32x4_t s, const float32x4_t rs)
+{
+    const uint16x8_t sumLo = vaddw_u8(vaddl_u8(vget_low_u8(a), vget_low_u8(b)), vget_low_u8(c));
+    const uint16x8_t sumHi = vaddw_u8(vaddl_u8(vget_high_u8(a), vget_high_u8(b)), vget_high_u8(c));
+    const uint16x8_t mcLo = vmovl_u8(vget_low_u8(mc));
+    const uint16x8_t mcHi = vmovl_u8(vget_high_u8(mc));
+
+    const uint32x4_t r0 = blendNEON(vget_low_u16(mcLo), vget_low_u16(sumLo), s, rs);
+    const uint32x4_t r1 = blendNEON(vget_high_u16(mcLo), vget_high_u16(sumLo), s, rs);
+    const uint32x4_t r2 = blendNEON(vget_low_u16(mcHi), vget_low_u16(sumHi), s, rs);
+    const uint32x4_t r3 = blendNEON(vget_high_u16(mcHi), vget_high_u16(sumHi), s, rs);
+
+    return vcombine_u8(
+        vmovn_u16(vcombine_u16(vmovn_u32(r0), vmovn_u32(r1))),
+        vmovn_u16(vcombine_u16(vmovn_u32(r2), vmovn_u32(r3))));
+}
+
+static inline uint8x16_t pushColorStepNEON(const uint8x16_t mc,
+    const uint8x16_t m1, const uint8x16_t a1, const uint8x16_t b1, const uint8x16_t c1,
+    const uint8x16_t m2, const uint8x16_t a2, const uint8x16_t b2, const uint8x16_t c2,
+    const float32x4_t s, const float32x4_t rs)
+{
+    uint8x16_t ret = mc;
+    if (anyNEON(m1))
+        ret = vbslq_u8(m1, lightestNEON(mc, a1, b1, c1, s, rs), ret);
+    if (anyNEON(m2))
+        ret = vbslq_u8(m2, lightestNEON(mc, a2, b2, c2, s, rs), ret);
+    return ret;
+}
+
+static int pushColorLineNEON(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const float32x4_t s = vdupq_n_f32(strength), rs = vdupq_n_f32(1 - strength);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const int j = i * 4;
+        const uint8x16_t tl = vld1q_u8(nLine + j - 4), tc = vld1q_u8(nLine + j), tr = vld1q_u8(nLine + j + 4);
+        const uint8x16_t ml = vld1q_u8(cLine + j - 4), mr = vld1q_u8(cLine + j + 4);
+        const uint8x16_t bl = vld1q_u8(pLine + j - 4), bc = vld1q_u8(pLine + j), br = vld1q_u8(pLine + j + 4);
+        uint8x16_t mc = vld1q_u8(dst + j);
+        uint8x16_t m1, m2;
+
+        //top and bottom
+        m1 = alphaMaskNEON(vandq_u8(vcgtq_u8(min3NEON(tl, tc, tr), mc), vcgtq_u8(mc, max3NEON(bl, bc, br))));
+        m2 = alphaMaskNEON(vandq_u8(vcgtq_u8(min3NEON(bl, bc, br), mc), vcgtq_u8(mc, max3NEON(tl, tc, tr))));
+        mc = pushColorStepNEON(mc, m1, tl, tc, tr, m2, bl, bc, br, s, rs);
+
+        //sundiagonal
+        m1 = alphaMaskNEON(vcgtq_u8(min3NEON(tc, tr, mr), max3NEON(ml, mc, bc)));
+        m2 = alphaMaskNEON(vcgtq_u8(min3NEON(ml, bl, bc), max3NEON(tc, mc, mr)));
+        mc = pushColorStepNEON(mc, m1, tc, tr, mr, m2, ml, bl, bc, s, rs);
+
+        //left and right
+        m1 = alphaMaskNEON(vandq_u8(vcgtq_u8(min3NEON(tr, mr, br), mc), vcgtq_u8(mc, max3NEON(tl, ml, bl))));
+        m2 = alphaMaskNEON(vandq_u8(vcgtq_u8(min3NEON(tl, ml, bl), mc), vcgtq_u8(mc, max3NEON(tr, mr, br))));
+        mc = pushColorStepNEON(mc, m1, tr, mr, br, m2, tl, ml, bl, s, rs);
+
+        //diagonal
+        m1 = alphaMaskNEON(vcgtq_u8(min3NEON(mr, br, bc), max3NEON(tc, mc, ml)));
+        m2 = alphaMaskNEON(vcgtq_u8(min3NEON(ml, tl, tc), max3NEON(bc, mc, mr)));
+        mc = pushColorStepNEON(mc, m1, mr, br, bc, m2, ml, tl, tc, s, rs);
+
+        vst1q_u8(dst + j, mc);
+    }
+    return i;
+}
+
+static inline void pushGradientStepNEON(uint8x16_t& ret, uint8x16_t& done, const uint8x16_t mc, const uint8x16_t cond,
+    const uint8x16_t a, const uint8x16_t b, const uint8x16_t c, const float32x4_t s, const float32x4_t rs)
+{
+    const uint8x16_t m = vbicq_u8(alphaMaskNEON(cond), done);
+    if (anyNEON(m))
+    {
+        ret = vbslq_u8(m, lightestNEON(mc, a, b, c, s, rs), ret);
+        done = vorrq_u8(done, m);
+    }
+}
+
+static int pushGradientLineNEON(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    const float32x4_t s = vdupq_n_f32(strength), rs = vdupq_n_f32(1 - strength);
+    const uint8x16_t alpha = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const int j = i * 4;
+        const uint8x16_t tl = vld1q_u8(nLine + j - 4), tc = vld1q_u8(nLine + j), tr = vld1q_u8(nLine + j + 4);
+        const uint8x16_t ml = vld1q_u8(cLine + j - 4), mr = vld1q_u8(cLine + j + 4);
+        const uint8x16_t bl = vld1q_u8(pLine + j - 4), bc = vld1q_u8(pLine + j), br = vld1q_u8(pLine + j + 4);
+        const uint8x16_t mc = vld1q_u8(dst + j);
+        uint8x16_t ret = mc, done = vdupq_n_u8(0);
+
+        //top and bottom
+        pushGradientStepNEON(ret, done, mc,
+            vandq_u8(vcgtq_u8(min3NEON(tl, tc, tr), mc), vcgtq_u8(mc, max3NEON(bl, bc, br))), tl, tc, tr, s, rs);
+        pushGradientStepNEON(ret, done, mc,
+            vandq_u8(vcgtq_u8(min3NEON(bl, bc, br), mc), vcgtq_u8(mc, max3NEON(tl, tc, tr))), bl, bc, br, s, rs);
+        //sundiagonal
+        pushGradientStepNEON(ret, done, mc, vcgtq_u8(min3NEON(tc, tr, mr), max3NEON(ml, mc, bc)), tc, tr, mr, s, rs);
+        pushGradientStepNEON(ret, done, mc, vcgtq_u8(min3NEON(ml, bl, bc), max3NEON(tc, mc, mr)), ml, bl, bc, s, rs);
+        //left and right
+        pushGradientStepNEON(ret, done, mc,
+            vandq_u8(vcgtq_u8(min3NEON(tr, mr, br), mc), vcgtq_u8(mc, max3NEON(tl, ml, bl))), tr, mr, br, s, rs);
+        pushGradientStepNEON(ret, done, mc,
+            vandq_u8(vcgtq_u8(min3NEON(tl, ml, bl), mc), vcgtq_u8(mc, max3NEON(tr, mr, br))), tl, ml, bl, s, rs);
+        //diagonal
+        pushGradientStepNEON(ret, done, mc, vcgtq_u8(min3NEON(mr, br, bc), max3NEON(tc, mc, ml)), mr, br, bc, s, rs);
+        pushGradientStepNEON(ret, done, mc, vcgtq_u8(min3NEON(ml, tl, tc), max3NEON(bc, mc, mr)), ml, tl, tc, s, rs);
+
+        vst1q_u8(dst + j, vorrq_u8(ret, alpha));
+    }
+    return i;
+}
+
+//conv8To8 for NEON, float only, 2 pixels at a time. Multiplies and adds stay separate as in convNToNKernel
+
+static int conv8To8LineNEON(float* dst, const float* nLine, const float* cLine, const float* pLine, int count, const float* kernels, const float* biases)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0F);
+    const float32x4_t biasLo = vld1q_f32(biases), biasHi = vld1q_f32(biases + 4);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const int j = i * 8;
+        const float* taps[9] = {
+            nLine + j - 8, nLine + j, nLine + j + 8,
+            cLine + j - 8, cLine + j, cLine + j + 8,
+            pLine + j - 8, pLine + j, pLine + j + 8 };
+        float32x4_t sum0Lo = zero, sum0Hi = zero, sum1Lo = zero, sum1Hi = zero;
+        for (int c = 0; c < 8; c++)
+        {
+            float32x4_t kLo = vld1q_f32(kernels + c * 8), kHi = vld1q_f32(kernels + c * 8 + 4);
+            const float* t = taps[0] + c;
+            float32x4_t x0 = vdupq_n_f32(t[0]), x1 = vdupq_n_f32(t[8]);
+            float32x4_t tmp0Lo = vmulq_f32(x0, kLo), tmp0Hi = vmulq_f32(x0, kHi);
+            float32x4_t tmp1Lo = vmulq_f32(x1, kLo), tmp1Hi = vmulq_f32(x1, kHi);
+            for (int n = 1; n < 9; n++)
+            {
+                const float* k = kernels + (n * 8 + c) * 8;
+                kLo = vld1q_f32(k);
+                kHi = vld1q_f32(k + 4);
+                t = taps[n] + c;
+                x0 = vdupq_n_f32(t[0]);
+                x1 = vdupq_n_f32(t[8]);
+                tmp0Lo = vaddq_f32(tmp0Lo, vmulq_f32(x0, kLo));
+                tmp0Hi = vaddq_f32(tmp0Hi, vmulq_f32(x0, kHi));
+                tmp1Lo = vaddq_f32(tmp1Lo, vmulq_f32(x1, kLo));
+                tmp1Hi = vaddq_f32(tmp1Hi, vmulq_f32(x1, kHi));
+            }
+            if (c)
+            {
+                sum0Lo = vaddq_f32(sum0Lo, tmp0Lo);
+                sum0Hi = vaddq_f32(sum0Hi, tmp0Hi);
+                sum1Lo = vaddq_f32(sum1Lo, tmp1Lo);
+                sum1Hi = vaddq_f32(sum1Hi, tmp1Hi);
+            }
+            else
+            {
+                sum0Lo = tmp0Lo;
+                sum0Hi = tmp0Hi;
+                sum1Lo = tmp1Lo;
+                sum1Hi = tmp1Hi;
+            }
+        }
+        vst1q_f32(dst + j, vmaxq_f32(zero, vaddq_f32(sum0Lo, biasLo)));
+        vst1q_f32(dst + j + 4, vmaxq_f32(zero, vaddq_f32(sum0Hi, biasHi)));
+        vst1q_f32(dst + j + 8, vmaxq_f32(zero, vaddq_f32(sum1Lo, biasLo)));
+        vst1q_f32(dst + j + 12, vmaxq_f32(zero, vaddq_f32(sum1Hi, biasHi)));
+    }
+    return i;
+}
+
+#endif // SIMD_NEON
+
+int Anime4KCPP::SIMD::pushColorLine(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    switch (getLevel())
+    {
+#ifdef SIMD_X86
+    case Level::AVX2:
+        return pushColorLineAVX2(dst, nLine, cLine, pLine, count, strength);
+    case Level::SSE41:
+        return pushColorLineSSE41(dst, nLine, cLine, pLine, count, strength);
+#endif
+#ifdef SIMD_NEON
+    case Level::NEON:
+        return pushColorLineNEON(dst, nLine, cLine, pLine, count, strength);
+#endif
+    default:
+        return 0;
+    }
+}
+
+int Anime4KCPP::SIMD::pushGradientLine(uint8_t* dst, const uint8_t* nLine, const uint8_t* cLine, const uint8_t* pLine, int count, float strength)
+{
+    switch (getLevel())
+    {
+#ifdef SIMD_X86
+    case Level::AVX2:
+        return pushGradientLineAVX2(dst, nLine, cLine, pLine, count, strength);
+    case Level::SSE41:
+        return pushGradientLineSSE41(dst, nLine, cLine, pLine, count, strength);
+#endif
+#ifdef SIMD_NEON
+    case Level::NEON:
+        return pushGradientLineNEON(dst, nLine, cLine, pLine, count, strength);
+#endif
+    default:
+        return 0;
+    }
+}
+
+int Anime4KCPP::SIMD::conv8To8Line(float* dst, const float* nLine, const float* cLine, const float* pLine, int count, const float* kernels, const float* biases)
+{
+    switch (getLevel())
+    {
+#ifdef SIMD_X86
+    case Level::AVX2:
+        return conv8To8LineAVX2(dst, nLine, cLine, pLine, count, kernels, biases);
+#endif
+#ifdef SIMD_NEON
+    case Level::NEON:
+        return conv8To8LineNEON(dst, nLine, cLine, pLine, count, kernels, biases);
+#endif
+    default:
+        return 0;
+    }
+}
+
+int Anime4KCPP::SIMD::conv8To8Line(double* dst, const double* nLine, const double* cLine, const double* pLine, int count, const double* kernels, const double* biases)
+{
+    switch (getLevel())
+    {
+#ifdef SIMD_X86
+    case Level::AVX2:
+        return conv8To8LineAVX2(dst, nLine, cLine, pLine, count, kernels, biases);
+#endif
+    default:
+        return 0;
+    }
+}
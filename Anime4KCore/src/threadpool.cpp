@@ -0,0 +1,68 @@
+#define DLL
+
+#include "threadpool.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include<windows.h>
+#elif defined(__linux__)
+#include<pthread.h>
+#include<sched.h>
+#endif
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+    return pool;
+}
+
+void ThreadPool::setLoopThreads(size_t count)
+{
+    loopThreads = std::min(std::max<size_t>(count, 1), threadCount);
+}
+
+size_t ThreadPool::getLoopThreads() const
+{
+    return loopThreads;
+}
+
+bool ThreadPool::pinWorkers()
+{
+#ifdef _WIN32
+    DWORD_PTR processMask = 0, systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+    std::vector<DWORD_PTR> cpus;
+    for (size_t i = 0; i < sizeof(DWORD_PTR) * 8; i++)
+        if (processMask & (DWORD_PTR(1) << i))
+            cpus.push_back(DWORD_PTR(1) << i);
+#elif defined(__linux__)
+    cpu_set_t processSet;
+    CPU_ZERO(&processSet);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &processSet) != 0)
+        return false;
+    std::vector<int> cpus;
+    for (int i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &processSet))
+            cpus.push_back(i);
+#else
+    std::vector<int> cpus;
+#endif
+    if (cpus.empty())
+        return false;
+    bool ret = true;
+    for (size_t i = 0; i < threadCount; i++)
+    {
+#ifdef _WIN32
+        ret &= SetThreadAffinityMask(threads[i].native_handle(), cpus[i % cpus.size()]) != 0;
+#elif defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpus[i % cpus.size()], &cpuSet);
+        ret &= pthread_setaffinity_np(threads[i].native_handle(), sizeof(cpu_set_t), &cpuSet) == 0;
+#endif
+    }
+    return ret;
+}
@@ -0,0 +1,111 @@
+#include "benchmark.h"
+
+#include <chrono>
+
+//body once to warm up, then ns per run over rounds runs
+template<typename F>
+static double timeRounds(F&& body, const int rounds)
+{
+    body();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+        body();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+//ns per pixel of a width x height frame
+template<typename F>
+static double timePixels(F&& body, const int width, const int height, const int rounds)
+{
+    return timeRounds(std::forward<F>(body), rounds) / (static_cast<double>(width) * height);
+}
+
+std::vector<std::pair<std::string, double>> Anime4KCPP::Benchmark::CPUPixelCalls(const int width, const int height, const int rounds)
+{
+    Anime4KCPU processor;
+    processor.W = width;
+    processor.H = height;
+    cv::Mat src(height, width, CV_8UC4, cv::Scalar(16, 96, 176, 255)), dst(height, width, CV_8UC4);
+
+    //the same work for every pixel, the gray of getGrayKernel
+    auto pixel = [](const int, const int, RGBA mc, const Line)
+    {
+        mc[A] = (mc[R] >> 2) + (mc[R] >> 4) + (mc[G] >> 1) + (mc[G] >> 4) + (mc[B] >> 3);
+    };
+    auto line = [width](const int, Line dstLine, const Line)
+    {
+        for (RGBA mc = dstLine; mc < dstLine + width * 4; mc += 4)
+            mc[A] = (mc[R] >> 2) + (mc[R] >> 4) + (mc[G] >> 1) + (mc[G] >> 4) + (mc[B] >> 3);
+    };
+    std::function<void(int, int, RGBA, Line)> pixelFunction = pixel;
+    std::function<void(int, Line, Line)> lineFunction = line;
+
+    return {
+        { "changEachPixelBGRA inlined", timePixels([&]() { processor.changEachPixelBGRA(src, dst, pixel); }, width, height, rounds) },
+        { "changEachPixelBGRA std::function", timePixels([&]() { processor.changEachPixelBGRA(src, dst, pixelFunction); }, width, height, rounds) },
+        { "changEachLineBGRA inlined", timePixels([&]() { processor.changEachLineBGRA(src, dst, line); }, width, height, rounds) },
+        { "changEachLineBGRA std::function", timePixels([&]() { processor.changEachLineBGRA(src, dst, lineFunction); }, width, height, rounds) }
+    };
+}
+
+std::vector<std::pair<std::string, double>> Anime4KCPP::Benchmark::filterPixelCalls(const int width, const int height, const int rounds)
+{
+    cv::Mat src(height, width, CV_8UC3, cv::Scalar(16, 96, 176)), dst;
+    FilterProcessor processor(src, 0);
+
+    //the same work for every pixel, the inverse of the source
+    auto pixel = [](const int, const int j, RGBA mc, const Line lineData)
+    {
+        mc[R] = 255 - lineData[j + R];
+        mc[G] = 255 - lineData[j + G];
+        mc[B] = 255 - lineData[j + B];
+    };
+    std::function<void(int, int, RGBA, Line)> pixelFunction = pixel;
+
+    return {
+        { "changEachPixelBGR inlined", timePixels([&]() { processor.changEachPixelBGR(src, dst, pixel); }, width, height, rounds) },
+        { "changEachPixelBGR std::function", timePixels([&]() { processor.changEachPixelBGR(src, dst, pixelFunction); }, width, height, rounds) }
+    };
+}
+
+std::vector<std::pair<std::string, double>> Anime4KCPP::Benchmark::GPUResources(const int width, const int height, const int rounds)
+{
+    if (!Anime4KGPU::isInitialized)
+        throw"GPU is not initialized";
+
+    //the sets of real frames are put aside and given back after, so the timing neither evicts them nor leaves its own
+    std::vector<Anime4KGPU::KernelResources> cache;
+    {
+        std::lock_guard<std::mutex> lock(Anime4KGPU::resourcesMutex);
+        cache.swap(Anime4KGPU::resourcesCache);
+    }
+    auto restore = [&]()
+    {
+        std::lock_guard<std::mutex> lock(Anime4KGPU::resourcesMutex);
+        for (const Anime4KGPU::KernelResources& res : Anime4KGPU::resourcesCache)
+            Anime4KGPU::freeResources(res);
+        Anime4KGPU::resourcesCache.swap(cache);
+    };
+
+    double created, cached;
+    try
+    {
+        created = timeRounds([&]() {
+            Anime4KGPU::freeResources(Anime4KGPU::acquireResources(0, width, height, width * 2, height * 2, false));
+            }, rounds) / 1000.0;
+        cached = timeRounds([&]() {
+            Anime4KGPU::recycleResources(Anime4KGPU::acquireResources(0, width, height, width * 2, height * 2, false));
+            }, rounds) / 1000.0;
+    }
+    catch (...)
+    {
+        restore();
+        throw;
+    }
+    restore();
+    return {
+        { "resources created for every frame", created },
+        { "resources from the cache", cached }
+    };
+}
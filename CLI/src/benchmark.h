@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Anime4KCPP.h"
+
+namespace Anime4KCPP
+{
+    class Benchmark;
+}
+
+//microbenchmarks of the internals of the processors, which let this class in as a friend, so the timing
+//code stays in the CLI instead of the API of the core library
+class Anime4KCPP::Benchmark
+{
+public:
+    //ns per pixel of changEachPixelBGRA and changEachLineBGRA of Anime4KCPU on a width x height frame, with a
+    //kernel inlined into the loop and with the same kernel called through std::function, which shows the cost of the call
+    static std::vector<std::pair<std::string, double>> CPUPixelCalls(const int width, const int height, const int rounds);
+    //the same for changEachPixelBGR of FilterProcessor
+    static std::vector<std::pair<std::string, double>> filterPixelCalls(const int width, const int height, const int rounds);
+    //microseconds per frame to get the kernels, images and buffers of Anime4KGPU for a width x height frame on the
+    //first device and give them back, taken from the cache as frames after the first are, and created and released
+    //for every frame as they were before the cache. The cache of real frames is left as it was
+    static std::vector<std::pair<std::string, double>> GPUResources(const int width, const int height, const int rounds);
+};
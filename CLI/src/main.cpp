@@ -1,8 +1,12 @@
 #include "Anime4KCPP.h"
+#include "benchmark.h"
+#include "verification.h"
 #include <cmdline.h>
 
 #include <iostream>
 #include <filesystem>
+#include <sstream>
+#include <fstream>
 
 #ifndef COMPILER
 #define COMPILER "Unknown"
@@ -26,6 +30,30 @@ bool mergeAudio2Video(const std::string& dstFile, const std::string& srcFile, co
     return false;
 }
 
+//concatenate the segment files without re-encoding and take the audio from srcFile like mergeAudio2Video
+bool mergeSegments2Video(const std::string& dstFile, const std::string& srcFile, const std::vector<std::string>& segmentFiles)
+{
+    std::string listFile = dstFile + ".segments.txt";
+    {
+        std::ofstream list(listFile);
+        for (const auto& file : segmentFiles)
+        {
+            //single quotes in a path of a concat list are written as '\''
+            std::string path = std::filesystem::absolute(file).string(), quoted;
+            for (char c : path)
+                quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+            list << "file '" << quoted << "'" << std::endl;
+        }
+    }
+
+    std::string command("ffmpeg -loglevel 40 -f concat -safe 0 -i \"" + listFile + "\" -i \"" + srcFile + "\" -c copy -map 0:v -map 1 -map -1:v  -y \"" + dstFile + "\"");
+    std::cout << command << std::endl;
+
+    bool ret = !system(command.data());
+    std::filesystem::remove(listFile);
+    return ret;
+}
+
 Anime4KCPP::CODEC string2Codec(const std::string& codec)
 {
     if (codec == "mp4v")
@@ -46,6 +74,509 @@ Anime4KCPP::CODEC string2Codec(const std::string& codec)
         return Anime4KCPP::CODEC::MP4V;
 }
 
+Anime4KCPP::ParallelPolicy string2ParallelPolicy(const std::string& policy)
+{
+    if (policy == "frame")
+        return Anime4KCPP::ParallelPolicy::FRAME;
+    else if (policy == "row")
+        return Anime4KCPP::ParallelPolicy::ROW;
+    else if (policy == "mixed")
+        return Anime4KCPP::ParallelPolicy::MIXED;
+    else
+        return Anime4KCPP::ParallelPolicy::AUTO;
+}
+
+//frames per second of every split the last video ran with
+void showSplitThroughput(const unsigned int threads)
+{
+    const char* names[] = { "auto", "frame", "row", "mixed" };
+    for (const auto& result : Anime4KCPP::VideoIO::instance().getSplitThroughput())
+    {
+        std::pair<size_t, size_t> split = Anime4KCPP::VideoIO::getSplit(result.first, threads);
+        std::cout << "Parallel policy " << names[static_cast<int>(result.first)]
+            << " (" << split.first << " frames x " << split.second << " threads for rows): "
+            << result.second << " fps" << std::endl;
+    }
+}
+
+//frame buffers the last video allocated and took back from the pool
+void showFrameBuffers()
+{
+    const Anime4KCPP::VideoIO& videoIO = Anime4KCPP::VideoIO::instance();
+    std::cout << "Frame buffers: " << videoIO.getFrameAllocations() << " allocated, "
+        << videoIO.getFrameReuses() << " reused" << std::endl;
+}
+
+//concatenate the segments of the last video into dstFile once all of them are written
+void mergeSegments(const std::string& dstFile, const std::string& srcFile, const bool ffmpeg, const bool allSegments)
+{
+    std::vector<std::string> segmentFiles = Anime4KCPP::VideoIO::instance().getSegmentFiles();
+    if (!allSegments || !ffmpeg)
+    {
+        std::cout << (ffmpeg ? "Segments written, concatenate them after all are done:" :
+            "Please install ffmpeg to concatenate the segments:") << std::endl;
+        for (const auto& file : segmentFiles)
+            std::cout << file << std::endl;
+        return;
+    }
+    if (mergeSegments2Video(dstFile, srcFile, segmentFiles))
+    {
+        for (const auto& file : segmentFiles)
+            std::filesystem::remove(file);
+        std::filesystem::remove(Anime4KCPP::VideoIO::instance().getIndexFile());
+    }
+}
+
+//FNV-1a over the pixels, equal for equal images whatever their row padding
+uint64_t hashImage(const cv::Mat& image)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const size_t rowBytes = image.cols * image.elemSize();
+    for (int y = 0; y < image.rows; y++)
+    {
+        const unsigned char* row = image.ptr<unsigned char>(y);
+        for (size_t x = 0; x < rowBytes; x++)
+            hash = (hash ^ row[x]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+//the same picture in every build, gradients, hard edges and noise, so every kernel has work to do
+cv::Mat makeTestImage()
+{
+    cv::Mat image(240, 320, CV_8UC3);
+    for (int y = 0; y < image.rows; y++)
+        for (int x = 0; x < image.cols; x++)
+            image.at<cv::Vec3b>(y, x) = cv::Vec3b(x * 255 / image.cols, y * 255 / image.rows, (x / 16 + y / 16) % 2 ? 220 : 30);
+    cv::Mat noise(image.size(), CV_8UC3);
+    cv::RNG rng(0x4B);
+    rng.fill(noise, cv::RNG::UNIFORM, 0, 48);
+    cv::add(image, noise, image);
+    cv::circle(image, cv::Point(160, 120), 60, cv::Scalar(255, 255, 255), 3);
+    cv::line(image, cv::Point(0, 239), cv::Point(319, 0), cv::Scalar(0, 0, 0), 2);
+    return image;
+}
+
+//process the test image again with buffers and caches reused, with rows on one thread and, on GPU, with copied
+//frames instead of frames used in place and with the separate kernels the fused one replaces, all of which must
+//give the same output. A non-zero expected hash, the one a baseline build printed for the same parameters, must
+//be matched as well
+bool verifyImage(Anime4KCPP::Anime4K* anime4k, const bool GPU, const uint64_t expected)
+{
+    const cv::Mat testImage = makeTestImage();
+    uint64_t reference = 0;
+    bool ret = true;
+    auto run = [&](const char* name)
+    {
+        anime4k->loadImage(testImage.clone());
+        std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+        anime4k->process();
+        std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        cv::Mat result;
+        anime4k->saveImage(result);
+        const uint64_t hash = hashImage(result);
+        if (!reference)
+            reference = expected ? expected : hash;
+        std::cout << name << ": " << std::hex << hash << std::dec << ", "
+            << std::chrono::duration_cast<std::chrono::microseconds>(e - s).count() / 1000.0 << " ms"
+            << (hash == reference ? "" : " MISMATCH") << std::endl;
+        ret &= hash == reference;
+    };
+
+    run("first run");
+    run("second run, buffers and caches reused");
+    ThreadPool& pool = ThreadPool::instance();
+    pool.setLoopThreads(1);
+    run("rows on one thread");
+    pool.setLoopThreads(pool.size());
+    if (GPU)
+    {
+        Anime4KCPP::Anime4KGPU::setZeroCopy(false);
+        run("frames copied instead of used in place");
+        Anime4KCPP::Anime4KGPU::setZeroCopy(true);
+        Anime4KCPP::Anime4KGPU::setFusedKernel(false);
+        run("pushColor, getGradient and pushGradient kernels instead of the fused one");
+        Anime4KCPP::Anime4KGPU::setFusedKernel(true);
+    }
+    std::cout << (ret ? "Output is the same in every run" : "Output differs between runs")
+        << (expected ? ret ? " and matches the expected hash" : " or from the expected hash" : "") << std::endl;
+    return ret;
+}
+
+//filter the test image with every pre and post filter on the GPU and with FilterProcessor. Median picks one of
+//the values it is given and has to match exactly, the others compute in float on the GPU and with integer or
+//table based paths in OpenCV, so they may round a channel one level apart, bilateral with its table of exp two
+bool verifyGPUFilters()
+{
+    const cv::Mat testImage = makeTestImage();
+    const std::pair<Anime4KCPP::FilterType, const char*> filters[] = {
+        { Anime4KCPP::MEDIAN_BLUR, "median blur" },
+        { Anime4KCPP::MEAN_BLUR, "mean blur" },
+        { Anime4KCPP::CAS_SHARPENING, "CAS sharpening" },
+        { Anime4KCPP::GAUSSIAN_BLUR_WEAK, "Gaussian blur weak" },
+        { Anime4KCPP::GAUSSIAN_BLUR, "Gaussian blur" },
+        { Anime4KCPP::BILATERAL_FILTER, "bilateral filter" },
+        { Anime4KCPP::BILATERAL_FILTER_FAST, "bilateral filter fast" }
+    };
+    bool ret = true;
+    for (const auto& [filter, name] : filters)
+    {
+        const double tolerance = filter == Anime4KCPP::MEDIAN_BLUR ? 0.0 :
+            filter & (Anime4KCPP::BILATERAL_FILTER | Anime4KCPP::BILATERAL_FILTER_FAST) ? 2.0 : 1.0;
+        cv::Mat reference = testImage.clone();
+        Anime4KCPP::FilterProcessor(reference, filter).process();
+        const cv::Mat result = Anime4KCPP::Verification::GPUFilters(testImage, filter);
+        cv::Mat diff;
+        cv::absdiff(reference, result, diff);
+        double maxDiff = 0.0;
+        cv::minMaxLoc(diff.reshape(1), nullptr, &maxDiff);
+        std::cout << "GPU " << name << ": at most " << maxDiff << " from FilterProcessor"
+            << (maxDiff <= tolerance ? "" : ", MORE than " + std::to_string(static_cast<int>(tolerance))) << std::endl;
+        ret &= maxDiff <= tolerance;
+    }
+    return ret;
+}
+
+//process random images, whose widths leave tails of every length to the scalar kernels, at every SIMD level the
+//CPU supports, which must give the output of the scalar kernels alone at level NONE
+bool verifySIMD(Anime4KCPP::Anime4KCreator& creator, Anime4KCPP::Parameters parameters)
+{
+    parameters.videoMode = false;
+    Anime4KCPP::Anime4K* processor = creator.create(parameters, Anime4KCPP::ProcessorType::CPU);
+    std::vector<cv::Mat> images;
+    cv::RNG rng(0x53494D44);
+    for (int cols : { 4, 7, 16, 33, 70, 131 })
+    {
+        //narrow ranges of values make the conditions of the kernels hold more often
+        cv::Mat image(24, cols, CV_8UC3);
+        const int low = rng.uniform(0, 200);
+        rng.fill(image, cv::RNG::UNIFORM, low, low + rng.uniform(8, 56));
+        images.push_back(image);
+    }
+    auto run = [&]()
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const cv::Mat& image : images)
+        {
+            processor->loadImage(image.clone());
+            processor->process();
+            cv::Mat result;
+            processor->saveImage(result);
+            hash = (hash ^ hashImage(result)) * 1099511628211ULL;
+        }
+        return hash;
+    };
+
+    const Anime4KCPP::SIMD::Level level = Anime4KCPP::SIMD::getLevel();
+    Anime4KCPP::SIMD::setLevel(Anime4KCPP::SIMD::Level::NONE);
+    const uint64_t reference = run();
+    bool ret = true;
+    for (Anime4KCPP::SIMD::Level other : { Anime4KCPP::SIMD::Level::SSE41, Anime4KCPP::SIMD::Level::AVX2, Anime4KCPP::SIMD::Level::NEON })
+    {
+        if (!Anime4KCPP::SIMD::setLevel(other))
+            continue;
+        const uint64_t hash = run();
+        std::cout << "SIMD " << Anime4KCPP::SIMD::getLevelName(other) << ": " << std::hex << hash << std::dec
+            << (hash == reference ? ", the same as scalar" : ", MISMATCH with scalar") << std::endl;
+        ret &= hash == reference;
+    }
+    Anime4KCPP::SIMD::setLevel(level);
+    creator.release(processor);
+    return ret;
+}
+
+//time the per pixel calls of the CPU loops, on GPU getting the kernels and images of a frame, frames of video
+//size in image mode, and the same frames as a video
+//in video mode, whose time includes decoding and encoding. On GPU each is processed once used in place and once copied to and from the device,
+//which only differ on devices sharing memory with the host, like CPUs under PoCL
+void benchmarkImage(Anime4KCPP::Anime4K* anime4k, Anime4KCPP::Parameters parameters, const bool GPU, const Anime4KCPP::CODEC codec)
+{
+    constexpr int rounds = 20;
+    cv::Mat testImage;
+    cv::resize(makeTestImage(), testImage, cv::Size(1920, 1080), 0.0, 0.0, cv::INTER_CUBIC);
+    //aligned like the frames of VideoIO, so it can be used in place
+    cv::Mat frame = Anime4KCPP::VideoIO::allocateFrame(testImage.rows, testImage.cols, CV_8UC3);
+    testImage.copyTo(frame);
+    auto run = [&](const char* name)
+    {
+        //the first one compiles kernels and creates buffers
+        anime4k->loadImage(frame);
+        anime4k->process();
+        std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+        {
+            anime4k->loadImage(frame);
+            anime4k->process();
+        }
+        std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        std::cout << name << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(e - s).count() / 1000.0 / rounds << " ms/frame" << std::endl;
+    };
+
+    //the per pixel loops of the CPU processor, with the kernel inlined and called through std::function
+    for (const auto& [name, ns] : Anime4KCPP::Benchmark::CPUPixelCalls(testImage.cols, testImage.rows, rounds))
+        std::cout << name << ": " << ns << " ns/pixel" << std::endl;
+    for (const auto& [name, ns] : Anime4KCPP::Benchmark::filterPixelCalls(testImage.cols, testImage.rows, rounds))
+        std::cout << name << ": " << ns << " ns/pixel" << std::endl;
+
+    if (GPU)
+    {
+        //the per frame overhead of the kernels and images of the GPU processor
+        for (const auto& [name, us] : Anime4KCPP::Benchmark::GPUResources(testImage.cols, testImage.rows, rounds))
+            std::cout << name << ": " << us << " us/frame" << std::endl;
+        run("frames used in place");
+        Anime4KCPP::Anime4KGPU::setZeroCopy(false);
+        run("frames copied");
+        Anime4KCPP::Anime4KGPU::setZeroCopy(true);
+    }
+    else
+        run("image mode");
+
+    const std::filesystem::path tmpDir = std::filesystem::temp_directory_path();
+    const std::string clip = (tmpDir / "Anime4KCPP_benchmark.mp4").string(), output = (tmpDir / "Anime4KCPP_benchmark_out.mp4").string();
+    {
+        cv::VideoWriter writer(clip, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), 24.0, frame.size());
+        for (int i = 0; i < rounds; i++)
+            writer.write(frame);
+    }
+    parameters.videoMode = true;
+    anime4k->setArguments(parameters);
+    anime4k->loadVideo(clip);
+    anime4k->setVideoSaveInfo(output, codec);
+    std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+    anime4k->process();
+    std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+    anime4k->saveVideo();
+    std::filesystem::remove(clip);
+    std::filesystem::remove(output);
+    std::cout << "video mode: "
+        << std::chrono::duration_cast<std::chrono::microseconds>(e - s).count() / 1000.0 / rounds << " ms/frame" << std::endl;
+    showFrameBuffers();
+    parameters.videoMode = false;
+    anime4k->setArguments(parameters);
+}
+
+//write the video with frame and with row parallelism and compare the decoded frames of both, which only
+//match if the output doesn't depend on threads, frame order or reused buffers. A non-zero expected hash of all
+//frames, printed by a baseline build for the same video, parameters and codec, must be matched as well.
+//The video played twice in a row must not allocate more frame buffers than once, as after the warm-up every
+//buffer should come from the pool
+bool verifyVideo(Anime4KCPP::Anime4K* anime4k, Anime4KCPP::Parameters parameters, const std::string& srcFile, const Anime4KCPP::CODEC codec,
+    const uint64_t expected)
+{
+    const std::filesystem::path tmpDir = std::filesystem::temp_directory_path();
+    std::vector<std::string> files;
+    std::vector<size_t> allocations;
+    auto run = [&](const std::string& src, Anime4KCPP::ParallelPolicy policy)
+    {
+        files.push_back((tmpDir / ("Anime4KCPP_verify" + std::to_string(files.size()) + ".mp4")).string());
+        parameters.parallelPolicy = policy;
+        anime4k->setArguments(parameters);
+        anime4k->loadVideo(src);
+        anime4k->setVideoSaveInfo(files.back(), codec);
+        std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+        anime4k->process();
+        std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        allocations.push_back(Anime4KCPP::VideoIO::instance().getFrameAllocations());
+        anime4k->saveVideo();
+        std::cout << files.back() << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(e - s).count() / 1000.0 << " s" << std::endl;
+        showFrameBuffers();
+    };
+    run(srcFile, Anime4KCPP::ParallelPolicy::FRAME);
+    run(srcFile, Anime4KCPP::ParallelPolicy::ROW);
+
+    const std::string twice = (tmpDir / "Anime4KCPP_verify_twice.avi").string();
+    size_t srcFrames = 0;
+    {
+        cv::VideoWriter writer;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            cv::VideoCapture reader(srcFile);
+            const double fps = reader.get(cv::CAP_PROP_FPS);
+            for (cv::Mat frame; reader.read(frame);)
+            {
+                if (!writer.isOpened())
+                    writer.open(twice, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), fps > 0.0 ? fps : 24.0, frame.size());
+                writer.write(frame);
+                srcFrames += !pass;
+            }
+        }
+    }
+    run(twice, Anime4KCPP::ParallelPolicy::FRAME);
+    std::filesystem::remove(twice);
+    std::filesystem::remove(files.back());
+    files.pop_back();
+    //a buffer lost on every other frame or more is a leak, a few more than once are warm-up jitter
+    const size_t grown = allocations.back() > allocations.front() ? allocations.back() - allocations.front() : 0;
+    const bool leaking = 2 * grown > srcFrames;
+
+    cv::VideoCapture first(files[0]), second(files[1]);
+    uint64_t hash = 14695981039346656037ULL;
+    size_t frames = 0, mismatches = 0;
+    for (cv::Mat a, b;;)
+    {
+        const bool readA = first.read(a), readB = second.read(b);
+        if (!readA || !readB)
+        {
+            mismatches += readA != readB;
+            break;
+        }
+        const uint64_t hashA = hashImage(a);
+        mismatches += hashA != hashImage(b);
+        hash = (hash ^ hashA) * 1099511628211ULL;
+        frames++;
+    }
+    first.release();
+    second.release();
+    for (const auto& file : files)
+        std::filesystem::remove(file);
+    std::cout << frames << " frames, hash " << std::hex << hash << std::dec << ", "
+        << (mismatches ? std::to_string(mismatches) + " frames differ between frame and row parallelism" : "the same with frame and row parallelism")
+        << (expected ? expected == hash ? ", matches the expected hash" : ", MISMATCH with the expected hash" : "") << std::endl;
+    std::cout << "Frame buffers played twice: " << allocations.back() << " allocated, " << allocations.front() << " once"
+        << (leaking ? ", STILL GROWING after the warm-up" : "") << std::endl;
+    return !mismatches && frames && (!expected || expected == hash) && !leaking;
+}
+
+//structural similarity of two 8 bit images of the same size averaged over channels, with the 11x11 Gaussian
+//window of sigma 1.5 and the constants of Wang et al.
+double SSIM(const cv::Mat& a, const cv::Mat& b)
+{
+    const double C1 = 6.5025, C2 = 58.5225;//(0.01 * 255)^2, (0.03 * 255)^2
+    std::vector<cv::Mat> channelsA, channelsB;
+    cv::split(a, channelsA);
+    cv::split(b, channelsB);
+    double sum = 0.0;
+    for (size_t c = 0; c < channelsA.size(); c++)
+    {
+        cv::Mat x, y;
+        channelsA[c].convertTo(x, CV_64F);
+        channelsB[c].convertTo(y, CV_64F);
+        cv::Mat mx, my, mxx, myy, mxy;
+        cv::GaussianBlur(x, mx, cv::Size(11, 11), 1.5);
+        cv::GaussianBlur(y, my, cv::Size(11, 11), 1.5);
+        cv::GaussianBlur(x.mul(x), mxx, cv::Size(11, 11), 1.5);
+        cv::GaussianBlur(y.mul(y), myy, cv::Size(11, 11), 1.5);
+        cv::GaussianBlur(x.mul(y), mxy, cv::Size(11, 11), 1.5);
+        const cv::Mat uxx = mx.mul(mx), uyy = my.mul(my), uxy = mx.mul(my);
+        cv::Mat numerator, denominator, map;
+        cv::multiply(2.0 * uxy + C1, 2.0 * (mxy - uxy) + C2, numerator);
+        cv::multiply(uxx + uyy + C1, (mxx - uxx) + (myy - uyy) + C2, denominator);
+        cv::divide(numerator, denominator, map);
+        sum += cv::mean(map)[0];
+    }
+    return channelsA.empty() ? 0.0 : sum / channelsA.size();
+}
+
+//run CPU CNN in double, the reference, in float and in INT8, and with GPU the GPU CNN as well, then print how
+//close each output is to the reference. Returns false if one falls below the PSNR and SSIM its precision should reach
+bool compareCNNPrecision(Anime4KCPP::Anime4KCreator& creator, Anime4KCPP::Parameters parameters, const bool GPU, const cv::Mat& image)
+{
+    parameters.videoMode = false;
+    auto run = [&](const Anime4KCPP::ProcessorType type, const Anime4KCPP::CNNPrecision precision, const char* name)
+    {
+        parameters.cnnPrecision = precision;
+        Anime4KCPP::Anime4K* processor = creator.create(parameters, type);
+        processor->loadImage(image.clone());
+        std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+        processor->process();
+        std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        cv::Mat result;
+        processor->saveImage(result);
+        result = result.clone();
+        creator.release(processor);
+        std::cout << name << ": " << std::chrono::duration_cast<std::chrono::microseconds>(e - s).count() / 1000.0 << " ms";
+        return result;
+    };
+
+    const cv::Mat reference = run(Anime4KCPP::ProcessorType::CPUCNN, Anime4KCPP::CNNPrecision::DOUBLE, "CPU double");
+    std::cout << ", reference" << std::endl;
+    //float only rounds differently from double, INT8 quantizes weights and activations
+    auto compare = [&](const cv::Mat& result, const double minPSNR, const double minSSIM)
+    {
+        const double psnr = cv::PSNR(reference, result), ssim = SSIM(reference, result);
+        const bool ok = psnr >= minPSNR && ssim >= minSSIM;
+        std::cout << ", PSNR " << psnr << " dB, SSIM " << ssim
+            << (ok ? "" : ", BELOW PSNR " + std::to_string(minPSNR) + " dB or SSIM " + std::to_string(minSSIM)) << std::endl;
+        return ok;
+    };
+    bool ret = compare(run(Anime4KCPP::ProcessorType::CPUCNN, Anime4KCPP::CNNPrecision::FLOAT, "CPU float"), 45.0, 0.999);
+    ret &= compare(run(Anime4KCPP::ProcessorType::CPUCNN, Anime4KCPP::CNNPrecision::INT8, "CPU int8"), 35.0, 0.98);
+    if (GPU)
+        ret &= compare(run(Anime4KCPP::ProcessorType::GPUCNN, Anime4KCPP::CNNPrecision::FLOAT, "GPU"), 45.0, 0.999);
+    return ret;
+}
+
+//run GPU CNN and CPU CNN in float on the same image, whose outputs may only differ by rounding to 8 bits. On a
+//CPU OpenCL runtime like PoCL this checks the OpenCL kernels without a GPU, so it can run in CI. It zooms by 2
+//whatever the parameters say, as a second pass and the Lanczos chroma would grow a difference of one level
+bool checkGPUCNN(Anime4KCPP::Anime4KCreator& creator, Anime4KCPP::Parameters parameters, const cv::Mat& image)
+{
+    constexpr double tolerance = 1.0;
+    parameters.videoMode = false;
+    parameters.zoomFactor = 2.0F;
+    parameters.cnnPrecision = Anime4KCPP::CNNPrecision::FLOAT;
+    auto run = [&](const Anime4KCPP::ProcessorType type)
+    {
+        Anime4KCPP::Anime4K* processor = creator.create(parameters, type);
+        processor->loadImage(image.clone());
+        processor->process();
+        cv::Mat result;
+        processor->saveImage(result);
+        result = result.clone();
+        creator.release(processor);
+        return result;
+    };
+
+    const cv::Mat reference = run(Anime4KCPP::ProcessorType::CPUCNN);
+    const cv::Mat result = run(Anime4KCPP::ProcessorType::GPUCNN);
+    if (result.size() != reference.size() || result.type() != reference.type())
+    {
+        std::cout << "GPU CNN output is " << result.cols << "x" << result.rows << ", CPU CNN output is "
+            << reference.cols << "x" << reference.rows << std::endl;
+        return false;
+    }
+    cv::Mat diff;
+    cv::absdiff(reference, result, diff);
+    diff = diff.reshape(1);
+    double maxDiff = 0.0;
+    cv::minMaxLoc(diff, nullptr, &maxDiff);
+    const int mismatches = cv::countNonZero(diff > tolerance);
+    std::cout << "GPU CNN against CPU CNN float: max difference " << maxDiff << ", "
+        << mismatches << " values differ by more than " << tolerance << std::endl;
+    return mismatches == 0;
+}
+
+//"0:0,0:1,1:0" to {platformID, deviceID} pairs, empty if the list is malformed
+std::vector<std::pair<unsigned int, unsigned int>> string2Devices(const std::string& devices)
+{
+    std::vector<std::pair<unsigned int, unsigned int>> ret;
+    std::istringstream list(devices);
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        unsigned int platformID = 0, deviceID = 0;
+        char colon = 0;
+        std::istringstream ids(item);
+        if (!(ids >> platformID >> colon >> deviceID) || colon != ':')
+            return {};
+        ret.emplace_back(platformID, deviceID);
+    }
+    return ret;
+}
+
+bool checkGPUs(const std::vector<std::pair<unsigned int, unsigned int>>& devices, const cl_device_type deviceType)
+{
+    for (const auto& ids : devices)
+    {
+        std::pair<bool, std::string> ret = Anime4KCPP::Anime4KGPU::checkGPUSupport(ids.first, ids.second, deviceType);
+        std::cout << ret.second << std::endl;
+        if (!ret.first)
+            return false;
+    }
+    return true;
+}
+
 inline void showVersionInfo()
 {
     std::cerr
@@ -68,6 +599,25 @@ int main(int argc, char* argv[])
     opt.add<float>("strengthGradient", 'g', "Strength for pushing gradient,range 0 to 1,higher for sharper", false, 1.0F, cmdline::range(0.0F, 1.0F));
     opt.add<float>("zoomFactor", 'z', "zoom factor for resizing", false, 2.0F);
     opt.add<unsigned int>("threads", 't', "Threads count for video processing", false, std::thread::hardware_concurrency(), cmdline::range(1, int(32 * std::thread::hardware_concurrency())));
+    opt.add<std::string>("parallelPolicy", 'T', "Split threads of video processing between frames and rows of each frame from \
+auto(try the others on the first frames and keep the fastest), frame, row, mixed", false, "auto", cmdline::oneof<std::string>("auto", "frame", "row", "mixed"));
+    opt.add("pinThreads", 'k', "Bind worker threads to the CPU cores the process may run on, spread round robin");
+    opt.add<unsigned int>("segments", 'S', "Cut the video into segments processed at once, each one decoded from a seek and written to a file of its own, \
+then concatenated by ffmpeg without re-encoding. The cuts are by frame count and only frame exact for constant frame rate video \
+in containers like mp4 or mkv, frames at them may be lost or repeated otherwise", false, 1, cmdline::range(1, 4096));
+    opt.add<std::string>("segmentRange", 'R', "Only process segments first to last - 1 as first:last like 0:4, \
+for sharing a video between machines, the segment files are kept for concatenating later", false, "");
+    opt.add<unsigned int>("checkpoint", 'K', "Start a new segment file every this many frames and record finished ones in an index \
+next to the output, 0 for never", false, 0);
+    opt.add("resume", 'y', "Skip the segment files a killed run finished, needs segments or checkpoint as that run had");
+    opt.add("benchmark", 'B', "Video: process the video with every parallel policy but auto and show the throughput of each. \
+Image: time the per pixel calls of the CPU loops, video sized frames in image mode, on GPU the kernels and images of a frame and frames used in place and copied, and as a video in video mode, for a CPU under PoCL run with -q -D cpu");
+    opt.add<std::string>("SIMDLevel", 'I', "Run the CPU kernels at a SIMD level from auto(the best the CPU supports), none(scalar only), \
+sse4.1, avx2, neon", false, "auto", cmdline::oneof<std::string>("auto", "none", "sse4.1", "avx2", "neon"));
+    opt.add("verify", 'Y', "Check that the output doesn't depend on reused buffers, threads, GPU copy mode or SIMD level on a built-in test image, \
+or on the parallel policy for the input video in video mode, and print its hash and time to compare builds");
+    opt.add<std::string>("verifyHash", 'H', "Hash --verify has to match as well, the one a baseline build printed with the same parameters, \
+and for video the same input and codec", false, "");
     opt.add("fastMode", 'f', "Faster but maybe low quality");
     opt.add("videoMode", 'v', "Video process");
     opt.add("preview", 's', "Preview image");
@@ -87,11 +637,27 @@ so you can put 40 to enable Gaussian blur weak and Bilateral filter, which also
 false, 40, cmdline::range(1, 127));
     opt.add("GPUMode", 'q', "Enable GPU acceleration");
     opt.add("CNNMode", 'w', "Enable CNN");
+    opt.add<std::string>("CNNPrecision", 'P', "Precision of CPU CNN from double(reference), float(faster), \
+int8(int8 weights and int16 feature maps, fastest and least exact)", false, "double", cmdline::oneof<std::string>("double", "float", "int8"));
+    opt.add("comparePrecision", 'Q', "Run CPU CNN in double, float and int8, and GPU CNN with GPUMode, on the input image or a built-in \
+test image and print the PSNR and SSIM of each against double");
+    opt.add("checkGPUCNN", 'G', "Run GPU CNN and CPU CNN in float on the input image or a built-in test image and exit with 1 \
+if they differ by more than rounding, on a CPU OpenCL runtime like PoCL unless deviceType is given, so no GPU is needed");
+    opt.add<std::string>("CNNModel", 'M', "Model file for CNN, use the built-in model if not specified", false, "");
     opt.add("listGPUs", 'l', "list GPUs");
     opt.add<unsigned int>("platformID", 'h', "Specify the platform ID", false, 0);
     opt.add<unsigned int>("deviceID", 'd', "Specify the device ID", false, 0);
+    opt.add<std::string>("devices", 'u', "Use several OpenCL devices at once and split video frames over them, \
+as platformID:deviceID separated by commas like 0:0,0:1,1:0, instead of platformID and deviceID", false, "");
+    opt.add<std::string>("deviceType", 'D', "Specify the OpenCL device type from gpu, cpu(OpenCL runtime on CPU like PoCL, for testing), all", false, "gpu", cmdline::oneof<std::string>("gpu", "cpu", "all"));
     opt.add<std::string>("codec", 'C', "Specify the codec for encoding from mp4v(recommended in Windows), dxva(for Windows), avc1(H264, recommended in Linux), vp09(very slow), \
 hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
+    opt.add<std::string>("encoder", 'E', "Specify the libav encoder like libx264 instead of the one of codec, needs a build with libav", false, "");
+    opt.add<unsigned int>("bitrate", 'X', "Bitrate of the encoder in kbit/s, 0 for the default of the encoder, needs a build with libav", false, 0);
+    opt.add<int>("crf", 'F', "Constant rate factor of the encoder, -1 for the default of the encoder, needs a build with libav", false, -1);
+    opt.add<std::string>("preset", 'x', "Preset of the encoder like medium, needs a build with libav", false, "");
+    opt.add<std::string>("pixelFormat", 'O', "Pixel format of the encoder like yuv420p, needs a build with libav", false, "");
+    opt.add<unsigned int>("encoderThreads", 'j', "Threads of the encoder, 0 for one per core, needs a build with libav", false, 0);
     opt.add("version", 'V', "print version information");
 
     opt.parse_check(argc, argv);
@@ -106,6 +672,40 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
     uint8_t preFilters = (uint8_t)opt.get<unsigned int>("preFilters");
     uint8_t postFilters = (uint8_t)opt.get<unsigned int>("postFilters");
     unsigned int threads = opt.get<unsigned int>("threads");
+    Anime4KCPP::ParallelPolicy parallelPolicy = string2ParallelPolicy(opt.get<std::string>("parallelPolicy"));
+    bool pinThreads = opt.exist("pinThreads");
+    bool benchmark = opt.exist("benchmark");
+    bool verify = opt.exist("verify");
+    const std::string SIMDLevel = opt.get<std::string>("SIMDLevel");
+    uint64_t expectedHash = 0;
+    if (opt.exist("verifyHash") && !(std::istringstream(opt.get<std::string>("verifyHash")) >> std::hex >> expectedHash))
+    {
+        std::cerr << "invalid hash, it should be the hex number --verify printed" << std::endl;
+        return 1;
+    }
+    unsigned int segments = opt.get<unsigned int>("segments");
+    std::string segmentRange = opt.get<std::string>("segmentRange");
+    std::pair<unsigned int, unsigned int> segmentRangeIDs{ 0, segments };
+    if (!segmentRange.empty())
+    {
+        char colon = 0;
+        std::istringstream ids(segmentRange);
+        if (!(ids >> segmentRangeIDs.first >> colon >> segmentRangeIDs.second) || colon != ':' ||
+            segmentRangeIDs.first >= segmentRangeIDs.second || segmentRangeIDs.second > segments)
+        {
+            std::cerr << "invalid segment range, it should be like 0:4 and within segments" << std::endl;
+            return 0;
+        }
+    }
+    bool allSegments = segmentRangeIDs.first == 0 && segmentRangeIDs.second == segments;
+    unsigned int checkpoint = opt.get<unsigned int>("checkpoint");
+    bool resume = opt.exist("resume");
+    bool useSegmentFiles = segments > 1 || checkpoint;
+    if (resume && !useSegmentFiles)
+    {
+        std::cerr << "resume needs segments or checkpoint" << std::endl;
+        return 0;
+    }
     bool fastMode = opt.exist("fastMode");
     bool videoMode = opt.exist("videoMode");
     bool preview = opt.exist("preview");
@@ -113,10 +713,30 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
     bool postProcessing = opt.exist("postprocessing");
     bool GPU = opt.exist("GPUMode");
     bool CNN = opt.exist("CNNMode");
+    const std::string precision = opt.get<std::string>("CNNPrecision");
+    Anime4KCPP::CNNPrecision CNNPrecision =
+        precision == "float" ? Anime4KCPP::CNNPrecision::FLOAT :
+        precision == "int8" ? Anime4KCPP::CNNPrecision::INT8 : Anime4KCPP::CNNPrecision::DOUBLE;
+    std::string CNNModel = opt.get<std::string>("CNNModel");
+    bool comparePrecision = opt.exist("comparePrecision");
+    bool checkCNN = opt.exist("checkGPUCNN");
     bool listGPUs = opt.exist("listGPUs");
     unsigned int pID = opt.get<unsigned int>("platformID");
     unsigned int dID = opt.get<unsigned int>("deviceID");
+    std::string devicesList = opt.get<std::string>("devices");
+    std::string deviceTypeName = opt.get<std::string>("deviceType");
+    cl_device_type deviceType =
+        deviceTypeName == "cpu" ? CL_DEVICE_TYPE_CPU : (deviceTypeName == "all" ? CL_DEVICE_TYPE_ALL : CL_DEVICE_TYPE_GPU);
+    if (checkCNN && !opt.exist("deviceType"))
+        deviceType = CL_DEVICE_TYPE_CPU;
     std::string codec = opt.get<std::string>("codec");
+    Anime4KCPP::EncoderOptions encoderOptions;
+    encoderOptions.encoder = opt.get<std::string>("encoder");
+    encoderOptions.bitRate = static_cast<int64_t>(opt.get<unsigned int>("bitrate")) * 1000;
+    encoderOptions.crf = opt.get<int>("crf");
+    encoderOptions.preset = opt.get<std::string>("preset");
+    encoderOptions.pixelFormat = opt.get<std::string>("pixelFormat");
+    encoderOptions.threads = static_cast<int>(opt.get<unsigned int>("encoderThreads"));
     bool version = opt.exist("version");
 
     if (version)
@@ -127,21 +747,45 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
 
     if (listGPUs)
     {
-        std::pair<std::pair<int, std::vector<int>>, std::string> ret = Anime4KCPP::Anime4KGPU::listGPUs();
+        std::pair<std::pair<int, std::vector<int>>, std::string> ret = Anime4KCPP::Anime4KGPU::listGPUs(deviceType);
         if (ret.first.first == 0)
             std::cout << "Error:" << std::endl;
         std::cout << ret.second << std::endl;
         return 0;
     }
 
+    if (SIMDLevel != "auto")
+    {
+        const Anime4KCPP::SIMD::Level level =
+            SIMDLevel == "sse4.1" ? Anime4KCPP::SIMD::Level::SSE41 :
+            SIMDLevel == "avx2" ? Anime4KCPP::SIMD::Level::AVX2 :
+            SIMDLevel == "neon" ? Anime4KCPP::SIMD::Level::NEON : Anime4KCPP::SIMD::Level::NONE;
+        if (!Anime4KCPP::SIMD::setLevel(level))
+        {
+            std::cerr << "SIMD level " << SIMDLevel << " is not supported by this CPU" << std::endl;
+            return 1;
+        }
+    }
+
     std::filesystem::path inputPath(input), outputPath(output);
-    if (!std::filesystem::exists(inputPath))
+    if (!checkCNN && !std::filesystem::exists(inputPath))
     {
         std::cerr << "input file or directory does not exist." << std::endl;
         return 0;
     }
 
-    Anime4KCPP::Anime4KCreator creator(GPU, pID, dID);
+    std::vector<std::pair<unsigned int, unsigned int>> devices{ { pID, dID } };
+    if (!devicesList.empty())
+    {
+        devices = string2Devices(devicesList);
+        if (devices.empty())
+        {
+            std::cerr << "invalid device list, it should be like 0:0,0:1" << std::endl;
+            return 0;
+        }
+    }
+
+    Anime4KCPP::Anime4KCreator creator(GPU || checkCNN, devices, deviceType);
     Anime4KCPP::Anime4K* anime4k = nullptr;
     Anime4KCPP::Parameters parameters(
         passes,
@@ -155,21 +799,45 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
         postProcessing,
         preFilters,
         postFilters,
-        threads
+        threads,
+        CNNPrecision,
+        parallelPolicy
     );
 
+    //the pool is shared by every processor of the run, its workers are pinned once for all of them
+    if (pinThreads && !ThreadPool::instance().pinWorkers())
+        std::cerr << "Failed to pin worker threads to CPU cores, they are left to the scheduler" << std::endl;
+
     try
     {
+        if (checkCNN)
+        {
+            if (!checkGPUs(devices, deviceType))
+                return 1;
+            if (!CNNModel.empty())
+                Anime4KCPP::Anime4KCPUCNN::loadModel(CNNModel);
+            cv::Mat image = std::filesystem::is_regular_file(inputPath) ? cv::imread(input, cv::IMREAD_COLOR) : cv::Mat();
+            if (image.empty())
+                image = makeTestImage();
+            return checkGPUCNN(creator, parameters, image) ? 0 : 1;
+        }
+
         if (CNN)
         {
             if (GPU)
             {
-                //TODO
-                return 0;
+                std::cout << "GPUCNN mode" << std::endl;
+                if (!checkGPUs(devices, deviceType))
+                    return 0;
+                if (!CNNModel.empty())
+                    Anime4KCPP::Anime4KCPUCNN::loadModel(CNNModel);
+                anime4k = creator.create(parameters, Anime4KCPP::ProcessorType::GPUCNN);
             }
             else
             {
                 std::cout << "CPUCNN mode" << std::endl;
+                if (!CNNModel.empty())
+                    Anime4KCPP::Anime4KCPUCNN::loadModel(CNNModel);
                 anime4k = creator.create(parameters, Anime4KCPP::ProcessorType::CPUCNN);
             }
         }
@@ -178,16 +846,8 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
             if (GPU)
             {
                 std::cout << "GPU mode" << std::endl;
-                std::pair<bool, std::string> ret = Anime4KCPP::Anime4KGPU::checkGPUSupport(pID, dID);
-                if (!ret.first)
-                {
-                    std::cout << ret.second << std::endl;
+                if (!checkGPUs(devices, deviceType))
                     return 0;
-                }
-                else
-                {
-                    std::cout << ret.second << std::endl;
-                }
                 anime4k = creator.create(parameters, Anime4KCPP::ProcessorType::GPU);
             }
             else
@@ -197,6 +857,34 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
             }
         }
 
+        if (comparePrecision)
+        {
+            if (!CNNModel.empty())
+                Anime4KCPP::Anime4KCPUCNN::loadModel(CNNModel);
+            cv::Mat image = std::filesystem::is_regular_file(inputPath) ? cv::imread(input, cv::IMREAD_COLOR) : cv::Mat();
+            if (image.empty())
+                image = makeTestImage();
+            bool ret = compareCNNPrecision(creator, parameters, GPU, image);
+            creator.release(anime4k);
+            return ret ? 0 : 1;
+        }
+
+        if (benchmark && !videoMode)
+        {
+            benchmarkImage(anime4k, parameters, GPU, string2Codec(codec));
+            creator.release(anime4k);
+            return 0;
+        }
+
+        if (verify)
+        {
+            bool ret = videoMode ?
+                verifyVideo(anime4k, parameters, inputPath.string(), string2Codec(codec), expectedHash) :
+                verifyImage(anime4k, GPU, expectedHash) & verifySIMD(creator, parameters) & (!GPU || verifyGPUFilters());
+            creator.release(anime4k);
+            return ret ? 0 : 1;
+        }
+
         if (!videoMode)//Image
         {
             if (std::filesystem::is_directory(inputPath))
@@ -251,12 +939,17 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
             outputPath.replace_extension(".mp4");
 
             bool ffmpeg = checkFFmpeg();
+            //libav copies the audio as the video is written, ffmpeg is then only needed to concatenate segments
+            bool copyAudio = Anime4KCPP::VideoIO::canCopyAudio();
             std::string outputTmpName = output;
 
-            if (!ffmpeg)
+            if (copyAudio)
+                encoderOptions.copyAudio = true;
+            else if (!ffmpeg)
                 std::cout << "Please install ffmpeg, otherwise the output file will be silent." << std::endl;
             else
                 outputTmpName = "tmp_out.mp4";
+            Anime4KCPP::VideoIO::instance().setEncoderOptions(encoderOptions);
 
             if (std::filesystem::is_directory(inputPath))
             {
@@ -272,7 +965,12 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
                     std::string currOnputPath = (outputPath / (file.path().filename().string() + ".mp4")).string();
 
                     anime4k->loadVideo(currInputPath);
-                    anime4k->setVideoSaveInfo(outputTmpName, string2Codec(codec));
+                    //segment files go next to the output, where other machines can find them
+                    anime4k->setVideoSaveInfo(useSegmentFiles || copyAudio ? currOnputPath : outputTmpName, string2Codec(codec), segments, checkpoint);
+                    if (segments > 1 && Anime4KCPP::VideoIO::instance().get(cv::CAP_PROP_FRAME_COUNT) <= 0)
+                        std::cout << "The frame count of the video is unknown, it is processed as one segment." << std::endl;
+                    Anime4KCPP::VideoIO::instance().setSegmentRange(segmentRangeIDs.first, segmentRangeIDs.second);
+                    Anime4KCPP::VideoIO::instance().setResume(resume);
 
                     anime4k->showInfo();
                     anime4k->showFiltersInfo();
@@ -282,10 +980,14 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
                     anime4k->process();
                     std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
                     std::cout << "Total process time: " << std::chrono::duration_cast<std::chrono::milliseconds>(e - s).count() / 1000.0 / 60.0 << " min" << std::endl;
+                    showSplitThroughput(threads);
+                    showFrameBuffers();
 
                     anime4k->saveVideo();
 
-                    if (ffmpeg && mergeAudio2Video(currOnputPath, currInputPath, outputTmpName))
+                    if (useSegmentFiles)
+                        mergeSegments(currOnputPath, currInputPath, ffmpeg, allSegments);
+                    else if (!copyAudio && ffmpeg && mergeAudio2Video(currOnputPath, currInputPath, outputTmpName))
                         std::filesystem::remove(outputTmpName);
                 }
             }
@@ -294,8 +996,30 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
                 std::string currInputPath = inputPath.string();
                 std::string currOnputPath = outputPath.string();
 
+                if (benchmark)
+                {
+                    for (Anime4KCPP::ParallelPolicy policy :
+                        { Anime4KCPP::ParallelPolicy::FRAME, Anime4KCPP::ParallelPolicy::MIXED, Anime4KCPP::ParallelPolicy::ROW })
+                    {
+                        parameters.parallelPolicy = policy;
+                        anime4k->setArguments(parameters);
+                        anime4k->loadVideo(currInputPath);
+                        anime4k->setVideoSaveInfo(outputTmpName, string2Codec(codec));
+                        anime4k->process();
+                        showSplitThroughput(threads);
+                        showFrameBuffers();
+                        anime4k->saveVideo();
+                    }
+                    parameters.parallelPolicy = parallelPolicy;
+                    anime4k->setArguments(parameters);
+                }
+
                 anime4k->loadVideo(currInputPath);
-                anime4k->setVideoSaveInfo(outputTmpName, string2Codec(codec));
+                anime4k->setVideoSaveInfo(useSegmentFiles || copyAudio ? currOnputPath : outputTmpName, string2Codec(codec), segments, checkpoint);
+                if (segments > 1 && Anime4KCPP::VideoIO::instance().get(cv::CAP_PROP_FRAME_COUNT) <= 0)
+                    std::cout << "The frame count of the video is unknown, it is processed as one segment." << std::endl;
+                Anime4KCPP::VideoIO::instance().setSegmentRange(segmentRangeIDs.first, segmentRangeIDs.second);
+                Anime4KCPP::VideoIO::instance().setResume(resume);
 
                 anime4k->showInfo();
                 anime4k->showFiltersInfo();
@@ -305,17 +1029,24 @@ hevc(not support in Windows), av01(not support in Windows)", false, "mp4v");
                 anime4k->process();
                 std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
                 std::cout << "Total process time: " << std::chrono::duration_cast<std::chrono::milliseconds>(e - s).count() / 1000.0 / 60.0 << " min" << std::endl;
+                showSplitThroughput(threads);
+                showFrameBuffers();
 
                 anime4k->saveVideo();
 
-                if (ffmpeg && mergeAudio2Video(currOnputPath, currInputPath, outputTmpName))
+                if (useSegmentFiles)
+                    mergeSegments(currOnputPath, currInputPath, ffmpeg, allSegments);
+                else if (!copyAudio && ffmpeg && mergeAudio2Video(currOnputPath, currInputPath, outputTmpName))
                     std::filesystem::remove(outputTmpName);
             }
         }
     }
     catch (const char* err)
     {
+        //an error, like a video written only in part, fails the run
         std::cout << err << std::endl;
+        creator.release(anime4k);
+        return 1;
     }
 
     creator.release(anime4k);
@@ -0,0 +1,31 @@
+#include "verification.h"
+
+cv::Mat Anime4KCPP::Verification::GPUFilters(const cv::Mat& image, const uint8_t filters)
+{
+    if (!Anime4KGPU::isInitialized)
+        throw"GPU is not initialized";
+
+    const cv::Mat src = image.isContinuous() ? image : image.clone();
+    cv::Mat dst(src.rows, src.cols, CV_8UC3);
+    const size_t size[2] = { size_t(src.cols), size_t(src.rows) };
+
+    //a set whose original and output size are both the size of the image, freed after so the cache of real
+    //frames gets nothing of it
+    Anime4KGPU::KernelResources res = Anime4KGPU::acquireResources(0, src.cols, src.rows, src.cols, src.rows, false);
+    cl_mem img = res.imageBuffer0, tmpImg = res.imageBuffer1;
+    cl_int err = clSetKernelArg(res.kernelUnpackBGR, 0, sizeof(cl_mem), &res.orgBGRBuffer);
+    err |= clSetKernelArg(res.kernelUnpackBGR, 1, sizeof(cl_mem), &res.imageBuffer0);
+    err |= clEnqueueWriteBuffer(res.queue, res.orgBGRBuffer, CL_FALSE, 0, src.total() * 3, src.data, 0, nullptr, nullptr);
+    err |= clEnqueueNDRangeKernel(res.queue, res.kernelUnpackBGR, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+    err |= Anime4KGPU::enqueueFilters(res, filters, img, tmpImg, size);
+    err |= clSetKernelArg(res.kernelPackBGR, 0, sizeof(cl_mem), &img);
+    err |= clSetKernelArg(res.kernelPackBGR, 1, sizeof(cl_mem), &res.dstBGRBuffer);
+    err |= clEnqueueNDRangeKernel(res.queue, res.kernelPackBGR, 2, nullptr, size, nullptr, 0, nullptr, nullptr);
+    err |= clEnqueueReadBuffer(res.queue, res.dstBGRBuffer, CL_TRUE, 0, dst.total() * 3, dst.data, 0, nullptr, nullptr);
+    //the write may still read src after a failed command
+    clFinish(res.queue);
+    Anime4KGPU::freeResources(res);
+    if (err != CL_SUCCESS)
+        throw"Failed to run the GPU filters";
+    return dst;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Anime4KCPP.h"
+
+namespace Anime4KCPP
+{
+    class Verification;
+}
+
+//runs parts of the processors alone for --verify to compare them with their CPU counterparts, the processors
+//let this class in as a friend
+class Anime4KCPP::Verification
+{
+public:
+    //the test image through the pre and post filter kernels of Anime4KGPU on the first device, as FilterProcessor
+    //would filter it on the CPU. Throws if the GPU isn't initialized or a command fails
+    static cv::Mat GPUFilters(const cv::Mat& image, const uint8_t filters);
+};
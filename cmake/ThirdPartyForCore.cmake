@@ -2,3 +2,10 @@ find_package(OpenCV REQUIRED)
 find_package(OpenCL REQUIRED)
 include_directories(${OpenCV_INCLUDE_DIRS} ${OpenCL_INCLUDE_DIRS})
 target_link_libraries(${PROJECT_NAME} ${OpenCV_LIBS} ${OpenCL_LIBRARIES})
+
+if(Enable_libav)
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(LIBAV REQUIRED libavformat libavcodec libavutil libswscale)
+    include_directories(${LIBAV_INCLUDE_DIRS})
+    target_link_libraries(${PROJECT_NAME} ${LIBAV_LINK_LIBRARIES})
+endif()